@@ -31,6 +31,9 @@
  *
  * // get the current time in microseconds
  * uint32_t currTime_us = cxa_timeBase_getCount_us();
+ *
+ * // or, for long-running timeouts, in nanoseconds (doesn't overflow)
+ * uint64_t currTime_ns = cxa_timeBase_getCount_ns();
  * @endcode
  */
 #ifndef CXA_TIMEBASE_H_
@@ -68,4 +71,23 @@ uint32_t cxa_timeBase_getCount_us(void);
 uint32_t cxa_timeBase_getMaxCount_us(void);
 
 
+/**
+ * @public
+ * @brief Returns the current monotonic, relative time in nanoseconds.
+ * Unlike ::cxa_timeBase_getCount_us, this value does not overflow during
+ * any practical uptime.
+ *
+ * @note On architectures without a native 64-bit counter the 32-bit
+ * 		counter is extended in software, so this must be called at least
+ * 		once per ::cxa_timeBase_getMaxCount_us (the run loop does so every
+ * 		iteration). The resolution is that of the underlying counter.
+ * 		The extension is updated within a ::cxa_criticalSection_enter, so
+ * 		this is only safe to call from interrupts on architectures whose
+ * 		critical sections mask them.
+ *
+ * @return the current time of the timeBase, in nanoseconds
+ */
+uint64_t cxa_timeBase_getCount_ns(void);
+
+
 #endif // CXA_TIMEBASE_H_
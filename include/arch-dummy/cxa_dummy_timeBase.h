@@ -0,0 +1,81 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains a simulated (virtual clock) implementation of the timeBase.
+ * Time only moves when explicitly advanced, which makes it possible to replay
+ * hours of timeouts, keep-alives and timed states in a fraction of a second
+ * (and deterministically). Link this in place of the architecture's timeBase.
+ *
+ * @note This file contains functionality in addition to that already provided in @ref cxa_timeBase.h
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_dummy_timeBase_init(0);
+ *
+ * // register entries, state machines, mqtt clients, etc
+ * ...
+ *
+ * // run a full day of virtual time, jumping straight between deadlines
+ * // (but never more than 10ms at a time while untimed entries are polling)
+ * cxa_dummy_timeBase_runLoop_simulate(CXA_RUNLOOP_THREADID_DEFAULT, 24UL * 60 * 60 * 1000, 10000);
+ * @endcode
+ */
+#ifndef CXA_DUMMY_TIMEBASE_H_
+#define CXA_DUMMY_TIMEBASE_H_
+
+
+// ******** includes ********
+#include <stdint.h>
+#include <cxa_config.h>
+#include <cxa_timeBase.h>
+
+
+// ******** global macro definitions ********
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Sets the virtual clock to the specified time
+ *
+ * @param[in] startTime_nsIn the initial value of ::cxa_timeBase_getCount_ns
+ */
+void cxa_dummy_timeBase_init(uint64_t startTime_nsIn);
+
+/**
+ * @public
+ * @brief Moves the virtual clock forward
+ *
+ * @param[in] delta_nsIn the number of nanoseconds to advance
+ */
+void cxa_dummy_timeBase_advance_ns(uint64_t delta_nsIn);
+
+/**
+ * @public
+ * @brief Iterates the specified thread's run loop for the specified amount
+ * of virtual time. After each iteration, the clock jumps directly to the
+ * thread's next timed deadline. When untimed entries are registered (and
+ * may be polling a timeDiff), each jump is limited to maxStep_usIn.
+ *
+ * @param[in] threadIdIn the id of the run loop thread to drive
+ * @param[in] duration_msIn the amount of virtual time to simulate
+ * @param[in] maxStep_usIn the largest jump taken while untimed entries
+ * 		are registered (must be > 0)
+ *
+ * @return the number of run loop iterations performed
+ */
+uint32_t cxa_dummy_timeBase_runLoop_simulate(int threadIdIn, uint32_t duration_msIn, uint32_t maxStep_usIn);
+
+
+#endif
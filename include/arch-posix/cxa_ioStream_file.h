@@ -11,7 +11,7 @@
 // ******** includes ********
 #include <stdbool.h>
 #include <stdio.h>
-#include <cxa_ioStream_file.h>
+#include <cxa_ioStream.h>
 
 
 // ******** global macro definitions ********
@@ -38,5 +38,11 @@ void cxa_ioStream_file_init(cxa_ioStream_file_t *const ioStreamIn);
 void cxa_ioStream_file_setFile(cxa_ioStream_file_t *const ioStreamIn, FILE *const fileIn);
 void cxa_ioStream_file_close(cxa_ioStream_file_t *const ioStreamIn);
 
+/**
+ * @public
+ * @return the underlying file descriptor (eg. for ::cxa_runLoop_addFdSource)
+ * 		or -1 if no file is currently set
+ */
+int cxa_ioStream_file_getFileDescriptor(cxa_ioStream_file_t *const ioStreamIn);
+
 #endif // CXA_IOSTREAM_FILE_H_
-o
@@ -28,6 +28,13 @@
  * uint8_t myByte;
  * cxa_usart_read(&usart, (void*)&myByte, 1, NULL);
  * @endcode
+ *
+ * Ports opened with ::cxa_posix_usart_init_noHH read with a 0.5 second timeout
+ * which will stall the calling run loop while the line is idle. Ports opened with
+ * ::cxa_posix_usart_init_noHH_nonBlocking never block: received bytes are read in
+ * bulk into a receive FIFO (by the run loop when the port becomes readable, or by a
+ * dedicated reader thread with ::cxa_posix_usart_init_noHH_readerThread) and the
+ * ioStream is served from that FIFO.
  */
 #ifndef CXA_POSIX_USART_H_
 #define CXA_POSIX_USART_H_
@@ -42,11 +49,54 @@
 #include <cxa_fixedFifo.h>
 #include <cxa_gpio.h>
 
+#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+	#include <pthread.h>
+	#include <stdatomic.h>
+#endif
+
 
 // ******** global macro definitions ********
+/**
+ * @public
+ * Size of the receive FIFO used by non-blocking ports
+ */
+#ifndef CXA_POSIX_USART_RXFIFO_SIZE_BYTES
+	#define CXA_POSIX_USART_RXFIFO_SIZE_BYTES			256
+#endif
+
+/**
+ * @public
+ * Maximum amount of time a write to a non-blocking port will wait for
+ * room in the kernel's transmit buffer before failing
+ */
+#ifndef CXA_POSIX_USART_WRITE_TIMEOUT_MS
+	#define CXA_POSIX_USART_WRITE_TIMEOUT_MS			1000
+#endif
+
+/**
+ * @public
+ * Define CXA_POSIX_USART_READERTHREAD_ENABLE in your cxa_config.h to make
+ * ::cxa_posix_usart_init_noHH_readerThread available. The reader thread
+ * feeds the receive FIFO without a critical section (see
+ * ::cxa_fixedFifo_initSpsc), so this also requires CXA_FF_SPSC_ENABLE.
+ */
+#if (defined CXA_POSIX_USART_READERTHREAD_ENABLE) && !(defined CXA_FF_SPSC_ENABLE)
+	#error "CXA_POSIX_USART_READERTHREAD_ENABLE requires CXA_FF_SPSC_ENABLE"
+#endif
 
 
 // ******** global type definitions *********
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_POSIX_USART_RXMODE_DIRECT,
+	CXA_POSIX_USART_RXMODE_NONBLOCKING,
+	CXA_POSIX_USART_RXMODE_READERTHREAD
+}cxa_posix_usart_rxMode_t;
+
+
 /**
  * @public
  */
@@ -55,6 +105,21 @@ typedef struct
 	cxa_usart_t super;
 
 	int fd;
+
+	cxa_posix_usart_rxMode_t rxMode;
+	int threadId;
+
+	// only used by non-blocking ports
+	cxa_fixedFifo_t rxFifo;
+	uint8_t rxFifo_buffer[CXA_POSIX_USART_RXFIFO_SIZE_BYTES];
+	bool isRxFifoFilledByRunLoop;
+	bool hasRxError;
+
+	#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+	pthread_t readerThread;
+	atomic_bool readerThread_shouldStop;
+	atomic_bool readerThread_hasError;
+	#endif
 }cxa_posix_usart_t;
 
 
@@ -74,11 +139,62 @@ bool cxa_posix_usart_init_noHH(cxa_posix_usart_t *const usartIn, char *const pat
 
 
 /**
- * Closes the specified serial port.
+ * @public
+ * @brief Same as ::cxa_posix_usart_init_noHH except the port is opened in non-blocking
+ * mode. Reads never wait: received bytes are pulled from the kernel in bulk into the
+ * port's receive FIFO. If the run loop supports file descriptor sources
+ * (CXA_RUNLOOP_MAXNUM_FDSOURCES > 0), the port is registered with the specified thread
+ * and only read when it is readable. Otherwise, the FIFO is refilled whenever it is
+ * empty and the ioStream is read. Writes complete once the kernel has buffered them.
+ *
+ * @param[in] usartIn pointer to a pre-allocated USART object
+ * @param[in] pathIn path to the target UART file device (eg. /dev/ttyUSB0)
+ * @param[in] baudRateIn the desired baud rate as specified in termios.h (eg. B115200)
+ * @param[in] threadIdIn the id of the run loop thread which will use this port
+ *
+ * @return true if successfully opened, false if not
+ */
+bool cxa_posix_usart_init_noHH_nonBlocking(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn);
+
+
+#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+/**
+ * @public
+ * @brief Same as ::cxa_posix_usart_init_noHH_nonBlocking except that the receive FIFO
+ * is filled by a dedicated reader thread (which wakes the specified run loop thread, if
+ * tickless, when data arrives). The ioStream must only be read from that run loop thread.
+ *
+ * @param[in] usartIn pointer to a pre-allocated USART object
+ * @param[in] pathIn path to the target UART file device (eg. /dev/ttyUSB0)
+ * @param[in] baudRateIn the desired baud rate as specified in termios.h (eg. B115200)
+ * @param[in] threadIdIn the id of the run loop thread which will use this port
+ *
+ * @return true if successfully opened, false if not
+ */
+bool cxa_posix_usart_init_noHH_readerThread(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn);
+#endif
+
+
+/**
+ * Closes the specified serial port (stopping its reader thread and / or
+ * removing it from the run loop, as applicable).
  *
  * @param[in] usartIn pointer to the pre-initialized serial port to close
  */
 void cxa_posix_usart_close(cxa_posix_usart_t *const usartIn);
 
 
+/**
+ * @public
+ * @brief Returns the file descriptor of the open serial port. Can be
+ * passed to ::cxa_runLoop_addFdSource so the port is only serviced
+ * when data is available.
+ *
+ * @param[in] usartIn pointer to the pre-initialized serial port
+ *
+ * @return the file descriptor of the serial port
+ */
+int cxa_posix_usart_getFileDescriptor(cxa_posix_usart_t *const usartIn);
+
+
 #endif // CXA_POSIX_USART_H_
@@ -0,0 +1,153 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains prototypes for a fixed-size pool of worker threads.
+ * Each worker owns a deque of pending tasks: it takes work from the back of
+ * its own deque and, when that runs dry, steals from the front of the others.
+ *
+ * @note This file contains functionality restricted to the CXA POSIX implementation.
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_posix_workerPool_t pool;
+ * cxa_posix_workerPool_init(&pool, 4);
+ *
+ * // queue some work
+ * cxa_posix_workerPool_submit(&pool, parseChunk, &chunks[0]);
+ * cxa_posix_workerPool_submit(&pool, parseChunk, &chunks[1]);
+ *
+ * // wait for it all to finish
+ * cxa_posix_workerPool_waitForIdle(&pool);
+ * @endcode
+ */
+#ifndef CXA_POSIX_WORKERPOOL_H_
+#define CXA_POSIX_WORKERPOOL_H_
+
+
+// ******** includes ********
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_WORKERPOOL_MAXNUM_WORKERS
+	#define CXA_POSIX_WORKERPOOL_MAXNUM_WORKERS			8
+#endif
+
+#ifndef CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER
+	#define CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER	16
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef void (*cxa_posix_workerPool_cb_t)(void* userVarIn);
+
+
+/**
+ * @public
+ * Forward declaration of cxa_posix_workerPool_t object
+ */
+typedef struct cxa_posix_workerPool cxa_posix_workerPool_t;
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_posix_workerPool_cb_t cb;
+	void* userVar;
+}cxa_posix_workerPool_task_t;
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_posix_workerPool_t* pool;
+	pthread_t thread;
+
+	pthread_mutex_t dequeMutex;
+	cxa_posix_workerPool_task_t deque[CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER];
+	size_t dequeHead;
+	size_t dequeSize;
+}cxa_posix_workerPool_worker_t;
+
+
+/**
+ * @private
+ */
+struct cxa_posix_workerPool
+{
+	cxa_posix_workerPool_worker_t workers[CXA_POSIX_WORKERPOOL_MAXNUM_WORKERS];
+	size_t numWorkers;
+	size_t nextWorkerIndex;
+
+	// only used to sleep / wake workers and waiters (tasks never touch it)
+	pthread_mutex_t mutex;
+	pthread_cond_t cond_workAvailable;
+	pthread_cond_t cond_idle;
+	bool shouldExit;
+
+	atomic_size_t numQueuedTasks;
+	atomic_size_t numPendingTasks;
+	atomic_size_t numSleepingWorkers;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the pool and starts its worker threads
+ *
+ * @param[in] poolIn pointer to a pre-allocated pool object
+ * @param[in] numWorkersIn number of worker threads to start
+ * 		(1 to CXA_POSIX_WORKERPOOL_MAXNUM_WORKERS)
+ */
+void cxa_posix_workerPool_init(cxa_posix_workerPool_t *const poolIn, size_t numWorkersIn);
+
+/**
+ * @public
+ * @brief Stops and joins all worker threads. Tasks which have not
+ * started yet are discarded.
+ *
+ * @param[in] poolIn pointer to a pre-initialized pool object
+ */
+void cxa_posix_workerPool_deinit(cxa_posix_workerPool_t *const poolIn);
+
+/**
+ * @public
+ * @brief Queues a task to be run on one of the pool's workers
+ *
+ * @param[in] poolIn pointer to a pre-initialized pool object
+ * @param[in] cbIn the function to run
+ * @param[in] userVarIn user variable passed to the function
+ */
+void cxa_posix_workerPool_submit(cxa_posix_workerPool_t *const poolIn, cxa_posix_workerPool_cb_t cbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Blocks until all submitted tasks have completed. The calling
+ * thread helps run queued tasks while it waits.
+ *
+ * @param[in] poolIn pointer to a pre-initialized pool object
+ */
+void cxa_posix_workerPool_waitForIdle(cxa_posix_workerPool_t *const poolIn);
+
+
+#endif
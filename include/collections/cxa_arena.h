@@ -0,0 +1,197 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a bump-pointer (arena) allocator over a statically
+ * allocated region of memory. Allocations cost a pointer increment and are never freed
+ * individually. Instead, a caller takes a mark, makes any number of transient allocations,
+ * then rewinds to the mark (or the whole arena is reset at once).
+ *
+ * This allows components to share one scratch region for short-lived buffers rather
+ * than each keeping its own worst-case buffer permanently. When registered with
+ * ::cxa_runLoop_setIterationArena, the arena is reset automatically at the end of
+ * every run loop iteration. Allocations from it are then valid until the current
+ * update callback returns to the run loop.
+ *
+ * @note This object is NOT thread-safe (use one arena per thread)
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_arena_t myArena;
+ * uint8_t myArena_buffer[1024];
+ *
+ * cxa_arena_initStd(&myArena, myArena_buffer);
+ *
+ * ...
+ *
+ * cxa_arena_mark_t mark = cxa_arena_getMark(&myArena);
+ * char* scratch = (char*)cxa_arena_alloc(&myArena, 128);
+ * if( scratch != NULL )
+ * {
+ *    // use scratch
+ * }
+ * cxa_arena_rewind(&myArena, mark);
+ * @endcode
+ */
+#ifndef CXA_ARENA_H_
+#define CXA_ARENA_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_ARENA_ALIGNMENT_BYTES
+	#define CXA_ARENA_ALIGNMENT_BYTES			(_Alignof(max_align_t))
+#endif
+
+
+/**
+ * @public
+ * @brief Shortcut to initialize the arena with a declared c-style array
+ *
+ * @param[in] arenaIn pointer to the arena to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which will back the arena
+ */
+#define cxa_arena_initStd(arenaIn, bufferIn)					cxa_arena_init((arenaIn), ((void*)(bufferIn)), sizeof(bufferIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_arena_t object
+ */
+typedef struct cxa_arena cxa_arena_t;
+
+
+/**
+ * @public
+ * @brief An opaque position within an arena (see ::cxa_arena_getMark)
+ */
+typedef size_t cxa_arena_mark_t;
+
+
+/**
+ * @private
+ */
+struct cxa_arena
+{
+	uint8_t* bufferLoc;
+	size_t maxSize_bytes;
+
+	size_t currOffset_bytes;
+	size_t highWatermark_bytes;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the (empty) arena using the specified memory region
+ *
+ * @param[in] arenaIn pointer to the pre-allocated cxa_arena_t object
+ * @param[in] bufferLocIn pointer to the pre-allocated memory region
+ * @param[in] bufferMaxSize_bytesIn the size of the memory region in bytes
+ */
+void cxa_arena_init(cxa_arena_t *const arenaIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Allocates the specified number of bytes from the arena, aligned
+ * 		to ::CXA_ARENA_ALIGNMENT_BYTES. The contents are NOT initialized.
+ *
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ * @param[in] numBytesIn the number of bytes to allocate
+ *
+ * @return pointer to the allocated bytes, NULL if there is not enough room
+ */
+void* cxa_arena_alloc(cxa_arena_t *const arenaIn, const size_t numBytesIn);
+
+
+/**
+ * @public
+ * @brief Same as ::cxa_arena_alloc, but zeroes the allocated bytes
+ *
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ * @param[in] numBytesIn the number of bytes to allocate
+ *
+ * @return pointer to the allocated bytes, NULL if there is not enough room
+ */
+void* cxa_arena_alloc_zeroed(cxa_arena_t *const arenaIn, const size_t numBytesIn);
+
+
+/**
+ * @public
+ * @brief Returns the current position of the arena. Passing it to
+ * 		::cxa_arena_rewind frees everything allocated after this call.
+ *
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ *
+ * @return the current position of the arena
+ */
+cxa_arena_mark_t cxa_arena_getMark(cxa_arena_t *const arenaIn);
+
+
+/**
+ * @public
+ * @brief Frees everything allocated since the specified mark was taken
+ *
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ * @param[in] markIn a mark previously returned by ::cxa_arena_getMark
+ * 		(must not be newer than the current position)
+ */
+void cxa_arena_rewind(cxa_arena_t *const arenaIn, const cxa_arena_mark_t markIn);
+
+
+/**
+ * @public
+ * @brief Frees everything allocated from the arena
+ *
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ */
+void cxa_arena_reset(cxa_arena_t *const arenaIn);
+
+
+/**
+ * @public
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ *
+ * @return the number of bytes currently allocated (including alignment padding)
+ */
+size_t cxa_arena_getUsedSize_bytes(cxa_arena_t *const arenaIn);
+
+
+/**
+ * @public
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ *
+ * @return the number of bytes still available (before alignment padding)
+ */
+size_t cxa_arena_getFreeSize_bytes(cxa_arena_t *const arenaIn);
+
+
+/**
+ * @public
+ * @param[in] arenaIn pointer to the pre-initialized arena
+ *
+ * @return the most bytes that have ever been allocated at one time (useful for sizing the arena)
+ */
+size_t cxa_arena_getHighWatermark_bytes(cxa_arena_t *const arenaIn);
+
+
+#endif // CXA_ARENA_H_
@@ -0,0 +1,367 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-length set of bits
+ * stored in machine words. Searches (find first set / find first clear), counting and
+ * iteration work a whole word at a time (using count-trailing-zeros and population count
+ * where the compiler provides them) so they are O(words) rather than O(bits). This makes it
+ * a good fit for tracking free slots or runnable entries in pools and schedulers.
+ *
+ * Like the other collections, the bitset does not hold any data itself. Rather, it stores
+ * the bits in an external buffer of ::cxa_bitset_word_t supplied during initialization
+ * (see ::CXA_BITSET_NUMWORDS for sizing it).
+ *
+ * When CXA_BITSET_ATOMIC_ENABLE is defined (in cxa_config.h), ::cxa_bitset_atomic_t is also
+ * available. Its words are C11 atomics so individual bits may be set, cleared and claimed
+ * from multiple threads without a critical section.
+ *
+ * @note ::cxa_bitset_t is NOT thread-safe
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_bitset_t myBits;
+ * cxa_bitset_word_t myBits_words[CXA_BITSET_NUMWORDS(40)];
+ *
+ * cxa_bitset_initStd(&myBits, 40, myBits_words);
+ *
+ * cxa_bitset_set(&myBits, 3);
+ * cxa_bitset_set(&myBits, 35);
+ *
+ * size_t freeIndex;
+ * if( cxa_bitset_findFirstClear(&myBits, &freeIndex) ) ...		// freeIndex == 0
+ *
+ * cxa_bitset_iterateSet(&myBits, currIndex)
+ * {
+ *    // currIndex == 3, then 35
+ * }
+ * @endcode
+ */
+#ifndef CXA_BITSET_H_
+#define CXA_BITSET_H_
+
+
+// ******** includes ********
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+#ifdef CXA_BITSET_ATOMIC_ENABLE
+	#include <stdatomic.h>
+#endif
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief The number of bits held by each ::cxa_bitset_word_t
+ */
+#define CXA_BITSET_BITS_PER_WORD								(sizeof(cxa_bitset_word_t) * CHAR_BIT)
+
+
+/**
+ * @public
+ * @brief Determines the number of words needed to hold the specified number of bits
+ *
+ * @param[in] numBitsIn the number of bits
+ */
+#define CXA_BITSET_NUMWORDS(numBitsIn)							(((numBitsIn) + CXA_BITSET_BITS_PER_WORD - 1) / CXA_BITSET_BITS_PER_WORD)
+
+
+/**
+ * @public
+ * @brief Shortcut to initialize the bitset with a declared c-style array of words
+ *
+ * @param[in] bitsetIn pointer to the bitset to initialize
+ * @param[in] numBitsIn the number of bits in the set
+ * @param[in] wordsIn pointer to the declared c-style array of ::cxa_bitset_word_t
+ */
+#define cxa_bitset_initStd(bitsetIn, numBitsIn, wordsIn)			cxa_bitset_init((bitsetIn), (numBitsIn), (wordsIn), sizeof(wordsIn))
+
+
+/**
+ * @public
+ * @brief Shortcut to iterate over the indices of all set bits (in ascending order)
+ *
+ * @code
+ * cxa_bitset_iterateSet(&myBits, currIndex)
+ * {
+ *    printf("%zu\n", currIndex);
+ * }
+ * @endcode
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] indexVarNameIn name of the loop variable (a size_t)
+ */
+#define cxa_bitset_iterateSet(bitsetIn, indexVarNameIn)			for( size_t indexVarNameIn = 0; cxa_bitset_findNextSet((bitsetIn), indexVarNameIn, &indexVarNameIn); indexVarNameIn++ )
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief The storage unit of the bitset
+ */
+typedef unsigned long cxa_bitset_word_t;
+
+
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_bitset_t object
+ */
+typedef struct cxa_bitset cxa_bitset_t;
+
+
+/**
+ * @private
+ */
+struct cxa_bitset
+{
+	cxa_bitset_word_t* words;
+	size_t numWords;
+	size_t numBits;
+};
+
+
+#ifdef CXA_BITSET_ATOMIC_ENABLE
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_bitset_atomic_t object
+ */
+typedef struct cxa_bitset_atomic cxa_bitset_atomic_t;
+
+
+/**
+ * @private
+ */
+struct cxa_bitset_atomic
+{
+	atomic_ulong* words;
+	size_t numWords;
+	size_t numBits;
+};
+#endif
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the bitset (all bits clear) using the specified buffer
+ *
+ * @param[in] bitsetIn pointer to the pre-allocated cxa_bitset_t object
+ * @param[in] numBitsIn the number of bits in the set
+ * @param[in] wordsIn pointer to the pre-allocated words
+ * @param[in] wordsSize_bytesIn the size of the words buffer in bytes
+ * 		(must hold at least ::CXA_BITSET_NUMWORDS(numBitsIn) words)
+ */
+void cxa_bitset_init(cxa_bitset_t *const bitsetIn, const size_t numBitsIn, cxa_bitset_word_t *const wordsIn, const size_t wordsSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Sets the bit at the specified index
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] indexIn index of the bit (must be less than the number of bits in the set)
+ */
+void cxa_bitset_set(cxa_bitset_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Clears the bit at the specified index
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] indexIn index of the bit (must be less than the number of bits in the set)
+ */
+void cxa_bitset_clear(cxa_bitset_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Sets or clears the bit at the specified index
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] indexIn index of the bit (must be less than the number of bits in the set)
+ * @param[in] valueIn true to set the bit, false to clear it
+ */
+void cxa_bitset_assign(cxa_bitset_t *const bitsetIn, const size_t indexIn, const bool valueIn);
+
+
+/**
+ * @public
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] indexIn index of the bit (must be less than the number of bits in the set)
+ *
+ * @return true if the bit at the specified index is set
+ */
+bool cxa_bitset_test(cxa_bitset_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Sets all bits in the set
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ */
+void cxa_bitset_setAll(cxa_bitset_t *const bitsetIn);
+
+
+/**
+ * @public
+ * @brief Clears all bits in the set
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ */
+void cxa_bitset_clearAll(cxa_bitset_t *const bitsetIn);
+
+
+/**
+ * @public
+ * @brief Finds the lowest set bit at or after the specified index
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[in] startIndexIn the index at which to start searching
+ * @param[out] indexOut the index of the set bit (only valid if this function returns true)
+ *
+ * @return true if a set bit was found
+ */
+bool cxa_bitset_findNextSet(cxa_bitset_t *const bitsetIn, const size_t startIndexIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @brief Finds the lowest set bit in the set
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[out] indexOut the index of the set bit (only valid if this function returns true)
+ *
+ * @return true if a set bit was found, false if all bits are clear
+ */
+bool cxa_bitset_findFirstSet(cxa_bitset_t *const bitsetIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @brief Finds the lowest clear bit in the set
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[out] indexOut the index of the clear bit (only valid if this function returns true)
+ *
+ * @return true if a clear bit was found, false if all bits are set
+ */
+bool cxa_bitset_findFirstClear(cxa_bitset_t *const bitsetIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ *
+ * @return the number of set bits
+ */
+size_t cxa_bitset_count(cxa_bitset_t *const bitsetIn);
+
+
+/**
+ * @public
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ *
+ * @return true if no bits are set
+ */
+bool cxa_bitset_isEmpty(cxa_bitset_t *const bitsetIn);
+
+
+/**
+ * @public
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ *
+ * @return the number of bits in the set
+ */
+size_t cxa_bitset_getSize_bits(cxa_bitset_t *const bitsetIn);
+
+
+#ifdef CXA_BITSET_ATOMIC_ENABLE
+/**
+ * @public
+ * @brief Initializes the atomic bitset (all bits clear) using the specified buffer.
+ * 		Initialization itself is NOT thread-safe.
+ *
+ * @param[in] bitsetIn pointer to the pre-allocated cxa_bitset_atomic_t object
+ * @param[in] numBitsIn the number of bits in the set
+ * @param[in] wordsIn pointer to the pre-allocated words
+ * @param[in] wordsSize_bytesIn the size of the words buffer in bytes
+ * 		(must hold at least ::CXA_BITSET_NUMWORDS(numBitsIn) words)
+ */
+void cxa_bitset_atomic_init(cxa_bitset_atomic_t *const bitsetIn, const size_t numBitsIn, atomic_ulong *const wordsIn, const size_t wordsSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Atomically sets the bit at the specified index
+ *
+ * @return true if the bit was previously set
+ */
+bool cxa_bitset_atomic_set(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Atomically clears the bit at the specified index
+ *
+ * @return true if the bit was previously set
+ */
+bool cxa_bitset_atomic_clear(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @return true if the bit at the specified index is set
+ */
+bool cxa_bitset_atomic_test(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Finds the lowest clear bit and atomically sets it. If multiple threads
+ * 		race for the same bit, exactly one of them gets it (the others move on to
+ * 		the next clear bit).
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[out] indexOut the index of the claimed bit (only valid if this function returns true)
+ *
+ * @return true if a bit was claimed, false if all bits are set
+ */
+bool cxa_bitset_atomic_claimFirstClear(cxa_bitset_atomic_t *const bitsetIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @brief Finds the lowest set bit and atomically clears it
+ *
+ * @param[in] bitsetIn pointer to the pre-initialized bitset
+ * @param[out] indexOut the index of the taken bit (only valid if this function returns true)
+ *
+ * @return true if a bit was taken, false if all bits are clear
+ */
+bool cxa_bitset_atomic_takeFirstSet(cxa_bitset_atomic_t *const bitsetIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @return the number of set bits (a snapshot...other threads may be modifying the set)
+ */
+size_t cxa_bitset_atomic_count(cxa_bitset_atomic_t *const bitsetIn);
+#endif
+
+
+#endif // CXA_BITSET_H_
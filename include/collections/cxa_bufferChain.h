@@ -0,0 +1,219 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-max-length chain of
+ * (pointer, length) segments which together describe one logical block of bytes that is
+ * scattered across memory (scatter-gather). This allows a packet to be assembled from a
+ * header buffer, an application-owned payload and a footer without first copying everything
+ * into one contiguous ::cxa_fixedByteBuffer_t.
+ *
+ * The chain does NOT copy or own the referenced bytes: they must remain valid (and unmodified)
+ * until the chain has been consumed (eg. by ::cxa_ioStream_writeBufferChain).
+ *
+ * @note The layout of ::cxa_bufferChain_segment_t intentionally matches POSIX `struct iovec`
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_bufferChain_t myChain;
+ * cxa_bufferChain_segment_t myChain_segments[4];
+ *
+ * cxa_bufferChain_initStd(&myChain, myChain_segments);
+ *
+ * cxa_bufferChain_append(&myChain, header, sizeof(header));
+ * cxa_bufferChain_append(&myChain, largePayload, largePayloadSize_bytes);
+ *
+ * // no intermediate copy of largePayload
+ * cxa_protocolParser_writePacket_chain(&myPp, &myChain);
+ * @endcode
+ */
+#ifndef CXA_BUFFERCHAIN_H_
+#define CXA_BUFFERCHAIN_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cxa_array.h>
+#include <cxa_fixedByteBuffer.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize the chain with a declared array of segments
+ *
+ * @code
+ * cxa_bufferChain_t myChain;
+ * cxa_bufferChain_segment_t mySegments[4];
+ *
+ * cxa_bufferChain_initStd(&myChain, mySegments);
+ * // equivalent to
+ * cxa_bufferChain_init(&myChain, mySegments, sizeof(mySegments));
+ * @endcode
+ *
+ * @param[in] chainIn pointer to the chain to initialize
+ * @param[in] segmentsIn pointer to the declared c-style array of ::cxa_bufferChain_segment_t
+ */
+#define cxa_bufferChain_initStd(chainIn, segmentsIn)						cxa_bufferChain_init((chainIn), (segmentsIn), sizeof(segmentsIn))
+
+
+/**
+ * @public
+ * @brief Shortcut to iterate over all segments in a chain
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[in] varNameIn name of the loop variable (a pointer to the current ::cxa_bufferChain_segment_t)
+ */
+#define cxa_bufferChain_iterate(chainIn, varNameIn)						cxa_array_iterate(&(chainIn)->segments, varNameIn, cxa_bufferChain_segment_t)
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_bufferChain_t object
+ */
+typedef struct cxa_bufferChain cxa_bufferChain_t;
+
+
+/**
+ * @public
+ * @brief A single contiguous run of bytes within the chain
+ */
+typedef struct
+{
+	void* data;
+	size_t size_bytes;
+}cxa_bufferChain_segment_t;
+
+
+/**
+ * @private
+ */
+struct cxa_bufferChain
+{
+	cxa_array_t segments;
+	size_t totalSize_bytes;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the chain (empty) using the specified segment buffer
+ *
+ * @param[in] chainIn pointer to the pre-allocated cxa_bufferChain_t object
+ * @param[in] segmentsIn pointer to the pre-allocated segment buffer
+ * @param[in] segmentsSize_bytesIn the size of the segment buffer in bytes
+ */
+void cxa_bufferChain_init(cxa_bufferChain_t *const chainIn, cxa_bufferChain_segment_t *const segmentsIn, const size_t segmentsSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Appends a reference to the specified bytes to the end of the chain (bytes are NOT copied).
+ * 		Zero-length segments are silently ignored.
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[in] dataIn pointer to the bytes to reference
+ * @param[in] numBytesIn the number of bytes (located at dataIn) to reference
+ *
+ * @return true on success, false if there are no free segments
+ */
+bool cxa_bufferChain_append(cxa_bufferChain_t *const chainIn, void *const dataIn, const size_t numBytesIn);
+
+
+/**
+ * @public
+ * @brief Appends a reference to the current contents of the specified fixedByteBuffer
+ * 		to the end of the chain (bytes are NOT copied). Structure-modifying actions
+ * 		on the fixedByteBuffer will NOT be reflected in the chain.
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[in] fbbIn pointer to the pre-initialized fixedByteBuffer
+ *
+ * @return true on success, false if there are no free segments
+ */
+bool cxa_bufferChain_append_fbb(cxa_bufferChain_t *const chainIn, cxa_fixedByteBuffer_t *const fbbIn);
+
+
+/**
+ * @public
+ * @brief Appends all segments of another chain to the end of this chain
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[in] sourceChainIn pointer to the pre-initialized chain whose segments should be appended
+ *
+ * @return true on success, false if there are not enough free segments (chain is unchanged)
+ */
+bool cxa_bufferChain_append_chain(cxa_bufferChain_t *const chainIn, cxa_bufferChain_t *const sourceChainIn);
+
+
+/**
+ * @public
+ * @brief Copies the contents of the chain (in order) into a contiguous buffer
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[out] bufferOut the buffer into which the bytes should be copied
+ * @param[in] maxSize_bytesIn the size of bufferOut in bytes
+ *
+ * @return the number of bytes copied (less than ::cxa_bufferChain_getSize_bytes if bufferOut is too small)
+ */
+size_t cxa_bufferChain_copyTo(cxa_bufferChain_t *const chainIn, void *const bufferOut, const size_t maxSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Returns the specified segment
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ * @param[in] indexIn the index of the desired segment
+ *
+ * @return pointer to the segment, NULL if the index is out-of-bounds
+ */
+cxa_bufferChain_segment_t* cxa_bufferChain_getSegment_atIndex(cxa_bufferChain_t *const chainIn, const size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of segments in the chain
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ *
+ * @return the number of segments in the chain
+ */
+size_t cxa_bufferChain_getNumSegments(cxa_bufferChain_t *const chainIn);
+
+
+/**
+ * @public
+ * @brief Determines the total number of bytes referenced by all segments of the chain
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ *
+ * @return the total number of bytes in the chain
+ */
+size_t cxa_bufferChain_getSize_bytes(cxa_bufferChain_t *const chainIn);
+
+
+/**
+ * @public
+ * @brief Removes all segments from the chain (the referenced bytes are untouched)
+ *
+ * @param[in] chainIn pointer to the pre-initialized chain
+ */
+void cxa_bufferChain_clear(cxa_bufferChain_t *const chainIn);
+
+
+#endif // CXA_BUFFERCHAIN_H_
@@ -76,6 +76,18 @@
  */
 #define cxa_fixedByteBuffer_initStd(fbbIn, bufferIn)						cxa_fixedByteBuffer_init((fbbIn), ((void*)(bufferIn)), sizeof(bufferIn))
 
+/**
+ * @public
+ * @brief Shortcut to initialize a fixedByteBuffer, reserving headroom, with a declared
+ * 		c-style array (see ::cxa_fixedByteBuffer_init_withHeadroom)
+ *
+ * @param[in] fbbIn pointer to the pre-allocated fixedByteBuffer object
+ * @param[in] bufferIn pointer to the declared c-style array which
+ * 		will contain the data for the fixedByteBuffer (including headroom)
+ * @param[in] headroom_bytesIn the number of bytes at the start of the buffer to reserve for prepends
+ */
+#define cxa_fixedByteBuffer_initStd_withHeadroom(fbbIn, bufferIn, headroom_bytesIn)	cxa_fixedByteBuffer_init_withHeadroom((fbbIn), ((void*)(bufferIn)), sizeof(bufferIn), (headroom_bytesIn))
+
 #define cxa_fixedByteBuffer_append_uint8(fbbIn, uint8In)					cxa_fixedByteBuffer_append((fbbIn), (uint8_t[]){(uint8In)}, 1)
 #define cxa_fixedByteBuffer_append_uint16LE(fbbIn, uint16In)				cxa_fixedByteBuffer_append((fbbIn), (uint8_t[]){((uint8_t)((((uint16_t)(uint16In)) & 0x00FF) >> 0)), ((uint8_t)((((uint16_t)(uint16In)) & 0xFF00) >> 8))}, 2)
 #define cxa_fixedByteBuffer_append_uint16BE(fbbIn, uint16In)				cxa_fixedByteBuffer_append((fbbIn), (uint8_t[]){((uint8_t)((((uint16_t)(uint16In)) & 0xFF00) >> 8)), ((uint8_t)((((uint16_t)(uint16In)) & 0x00FF) >> 0))}, 2)
@@ -127,6 +139,9 @@ typedef struct cxa_fixedByteBuffer cxa_fixedByteBuffer_t;
 struct cxa_fixedByteBuffer
 {
 	cxa_array_t bytes;
+
+	uint8_t* bufferBase;
+	size_t initialHeadroom_bytes;
 };
 
 
@@ -144,6 +159,37 @@ struct cxa_fixedByteBuffer
 void cxa_fixedByteBuffer_init(cxa_fixedByteBuffer_t *const fbbIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn);
 
 
+/**
+ * @public
+ * @brief Initializes the pre-allocated fixedByteBuffer using the specified
+ *		buffer to store elements, reserving the first 'headroom_bytesIn' bytes
+ *		of the buffer for inserts near the start of the data.
+ *
+ * Inserts that land closer to the start of the data than the end will grow
+ * the data backwards into the headroom (moving only the bytes before the
+ * insertion point) rather than moving all following bytes. This makes
+ * repeatedly prepending to a header cost O(header size) instead of O(packet size).
+ * Removing those bytes again returns them to the headroom. Unused headroom
+ * is NOT counted by ::cxa_fixedByteBuffer_getMaxSize_bytes or
+ * ::cxa_fixedByteBuffer_getFreeSize_bytes. Headroom consumed by a prepend
+ * holds data, so it is counted by ::cxa_fixedByteBuffer_getMaxSize_bytes
+ * (which grows by the same amount as ::cxa_fixedByteBuffer_getSize_bytes,
+ * leaving the free size unchanged). Indices (and max sizes) are always
+ * relative to the current start of the data. ::cxa_fixedByteBuffer_clear
+ * restores the original headroom.
+ *
+ * @note pointers into the buffer obtained before an insert/remove may
+ * 		be invalidated by the insert/remove (as is the case without headroom)
+ *
+ * @param[in] fbbIn pointer to the pre-allocated fixedByteBuffer object
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will
+ * 		be used to store elements in the buffer
+ * @param[in] bufferMaxSize_bytesIn the size of the chunk of memory (buffer) in bytes (including headroom)
+ * @param[in] headroom_bytesIn the number of bytes at the start of the buffer to reserve for prepends
+ */
+void cxa_fixedByteBuffer_init_withHeadroom(cxa_fixedByteBuffer_t *const fbbIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn, const size_t headroom_bytesIn);
+
+
 /**
  * @public
  * @brief Initializes the pre-allocated fixedByteBuffer using the
@@ -348,6 +394,7 @@ size_t cxa_fixedByteBuffer_getSize_bytes(cxa_fixedByteBuffer_t *const fbbIn);
 /**
  * @public
  * @brief Determines the maximum number of bytes that can be contained within this buffer
+ * (excluding any unused headroom, see ::cxa_fixedByteBuffer_init_withHeadroom)
  *
  * @param[in] fbbIn pointer to the pre-initialized fixedByteBuffer object
  *
@@ -400,4 +447,16 @@ bool cxa_fixedByteBuffer_isEmpty(cxa_fixedByteBuffer_t *const fbbIn);
 void cxa_fixedByteBuffer_clear(cxa_fixedByteBuffer_t *const fbbIn);
 
 
+/**
+ * @public
+ * @brief Determines the number of bytes currently available before the start of
+ * 		the data for prepends (see ::cxa_fixedByteBuffer_init_withHeadroom)
+ *
+ * @param[in] fbbIn pointer to the pre-initialized fixedByteBuffer object
+ *
+ * @return the number of bytes of headroom currently available
+ */
+size_t cxa_fixedByteBuffer_getHeadroom_bytes(cxa_fixedByteBuffer_t *const fbbIn);
+
+
 #endif // CXA_FIXED_BYTE_BUFFER_H_
@@ -14,6 +14,13 @@
  *
  * @note This object should work across all architecture-specific implementations
  *
+ * When CXA_FF_SPSC_ENABLE is defined (in cxa_config.h), a FIFO initialized with
+ * ::cxa_fixedFifo_initSpsc may be shared between exactly one producer (eg. an ISR or
+ * reader thread) and exactly one consumer (eg. the run loop) without a critical section.
+ * Its indices are published with release / observed with acquire ordering. FIFOs
+ * initialized with ::cxa_fixedFifo_init are unaffected (other than their indices
+ * becoming relaxed C11 atomics).
+ *
  *
  * #### Example Usage: ####
  *
@@ -60,6 +67,10 @@
 #include <cxa_array.h>
 #include <cxa_config.h>
 
+#ifdef CXA_FF_SPSC_ENABLE
+	#include <stdatomic.h>
+#endif
+
 
 // ******** global macro definitions ********
 /**
@@ -74,6 +85,18 @@
 #endif
 
 
+/**
+ * @public
+ * The size (in bytes) of a cache line on the target. When > 0 (and
+ * CXA_FF_SPSC_ENABLE is defined) the producer and consumer indices are
+ * placed on separate cache lines. Since this pads _every_ FIFO, it is
+ * off by default.
+ */
+#ifndef CXA_FF_CACHELINE_SIZE
+	#define CXA_FF_CACHELINE_SIZE		0
+#endif
+
+
 /**
  * @public
  * @brief Shortcut to initialize the fifo with a buffer of an explict data type
@@ -96,6 +119,20 @@
 #define cxa_fixedFifo_initStd(fifoIn, onFullActionIn, bufferIn)						cxa_fixedFifo_init((fifoIn), (onFullActionIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn))
 
 
+#ifdef CXA_FF_SPSC_ENABLE
+/**
+ * @public
+ * @brief Shortcut to initialize a single-producer / single-consumer fifo
+ * 		with a buffer of an explicit data type (see ::cxa_fixedFifo_initSpsc)
+ *
+ * @param[in] fifoIn pointer to FIFO to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which
+ * 		will contain the data for the FIFO.
+ */
+#define cxa_fixedFifo_initSpscStd(fifoIn, bufferIn)								cxa_fixedFifo_initSpsc((fifoIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn))
+#endif
+
+
 // ******** global type definitions *********
 /**
  * @public
@@ -149,14 +186,25 @@ struct cxa_fixedFifo
 {
 	void *bufferLoc;
 
-	volatile size_t insertIndex;
-	volatile size_t removeIndex;
-
 	size_t datatypeSize_bytes;
 	size_t maxNumElements;
 
 	cxa_fixedFifo_onFullAction_t onFullAction;
 
+	#ifdef CXA_FF_SPSC_ENABLE
+	bool isSpsc;
+	#if CXA_FF_CACHELINE_SIZE > 0
+	_Alignas(CXA_FF_CACHELINE_SIZE) atomic_size_t insertIndex;		// written by producer only
+	_Alignas(CXA_FF_CACHELINE_SIZE) atomic_size_t removeIndex;		// written by consumer only
+	#else
+	atomic_size_t insertIndex;
+	atomic_size_t removeIndex;
+	#endif
+	#else
+	volatile size_t insertIndex;
+	volatile size_t removeIndex;
+	#endif
+
 	#if CXA_FF_MAX_LISTENERS > 0
 	cxa_array_t listeners;
 	cxa_fixedFifo_listener_entry_t listeners_raw[CXA_FF_MAX_LISTENERS];
@@ -181,6 +229,30 @@ struct cxa_fixedFifo
 void cxa_fixedFifo_init(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_onFullAction_t onFullActionIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn);
 
 
+#ifdef CXA_FF_SPSC_ENABLE
+/**
+ * @public
+ * @brief Initializes a FIFO which is shared between exactly one producer and
+ * 		exactly one consumer (without a critical section). Queues to a full
+ * 		FIFO are always dropped (::CXA_FF_ON_FULL_DEQUEUE would have the producer
+ * 		modify the consumer's index).
+ *
+ * The producer may only call the queue functions (including
+ * ::cxa_fixedFifo_bulkQueue_reserve / ::cxa_fixedFifo_bulkQueue_commit), the
+ * consumer only the peek / dequeue functions. ::cxa_fixedFifo_clear is not
+ * safe while either side is active.
+ *
+ * @param[in] fifoIn pointer to the pre-allocated cxa_fixedFifo_t object
+ * @param[in] datatypeSize_bytesIn the size of each element that will be inserted
+ * 		into the FIFO (all elements MUST be the same size)
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will
+ * 		be used to store elements in the FIFO (the buffer)
+ * @param[in] bufferMaxSize_bytesIn the maximum size of the chunk of memory (buffer) in bytes
+ */
+void cxa_fixedFifo_initSpsc(cxa_fixedFifo_t *const fifoIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn);
+#endif
+
+
 #if CXA_FF_MAX_LISTENERS > 0
 /**
  * @public
@@ -245,7 +317,11 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut);
 
 /**
  * @public
- * @brief Convenience function for queueing multiple contiguous elements in one call.
+ * @brief Queues multiple contiguous elements in one call (using at most two
+ * 		copies, one on either side of the buffer's wrap point).
+ *
+ * If the elements do not all fit and the FIFO was initialized with
+ * ::CXA_FF_ON_FULL_DROP, as many elements as will fit are queued.
  *
  * @param[in] fifoIn pointer to the pre-initialized FIFO object
  * @param[in] elemsIn pointer to the contiguous elements which will be copied into
@@ -259,6 +335,37 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut);
 bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn, size_t numElemsIn);
 
 
+/**
+ * @public
+ * @brief Provides direct access to the free space of the FIFO so that a producer
+ * 		(eg. a call to `read()`) can write elements straight into the FIFO's buffer.
+ * 		Must be followed by a call to ::cxa_fixedFifo_bulkQueue_commit.
+ *
+ * Like ::cxa_fixedFifo_bulkDequeue_peek, only the contiguous free space following
+ * the insert position is returned. If the free space wraps around the end of the
+ * buffer, a second reserve / commit after the first will return the remainder.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut a pointer that will be set with the address (within the
+ * 		FIFO buffer itself) at which the next element should be written
+ *
+ * @return the number of contiguous elements that may be written
+ */
+size_t cxa_fixedFifo_bulkQueue_reserve(cxa_fixedFifo_t *const fifoIn, void **const elemsOut);
+
+
+/**
+ * @public
+ * @brief Completes a bulk queue started with ::cxa_fixedFifo_bulkQueue_reserve,
+ * 		making the written elements available to the consumer.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] numElemsIn the number of elements actually written (must not exceed
+ * 		the number returned by ::cxa_fixedFifo_bulkQueue_reserve)
+ */
+void cxa_fixedFifo_bulkQueue_commit(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn);
+
+
 /**
  * @public
  * @brief Convenience function for dequeueing multiple elements in one call. This
@@ -273,6 +380,21 @@ bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn,
 bool cxa_fixedFifo_bulkDequeue(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn);
 
 
+/**
+ * @public
+ * @brief Dequeues (and copies out) up to the specified number of elements in one
+ * 		call (using at most two copies, one on either side of the buffer's wrap point).
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut pointer to where the elements should be copied (must have
+ * 		room for maxNumElemsIn elements). May be NULL if no copy is desired.
+ * @param[in] maxNumElemsIn the maximum number of elements to dequeue
+ *
+ * @return the number of elements actually dequeued
+ */
+size_t cxa_fixedFifo_bulkDequeue_copy(cxa_fixedFifo_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn);
+
+
 /**
  * @public
  * @brief 'Peeks' at the queue and determines the maximum number of contiguous elements
@@ -0,0 +1,243 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-capacity hash
+ * map from keys (either integers or null-terminated strings) to user-supplied pointers.
+ * Collisions are resolved using open addressing with robin-hood linear probing, which
+ * keeps probe sequences short (and lookups of missing keys cheap) even when the map
+ * is fairly full. Like the other collections, the map stores its entries in an external
+ * buffer supplied during initialization and never allocates.
+ *
+ * @note String keys are NOT copied: the string must remain valid (and unmodified) for
+ * as long as it is in the map (string literals are ideal).
+ *
+ * @note For best performance, size the entry buffer so that the map is no more
+ * than ~75% full.
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_hashMap_t myMap;
+ * cxa_hashMap_entry_t myMap_entries[32];
+ *
+ * cxa_hashMap_initStd(&myMap, CXA_HASHMAP_KEYTYPE_STRING, myMap_entries);
+ *
+ * cxa_hashMap_put_str(&myMap, "reboot", (void*)&rebootHandler);
+ * ...
+ * void* handler;
+ * if( cxa_hashMap_get_str(&myMap, cmdName, &handler) ) { ... }
+ * @endcode
+ */
+#ifndef CXA_HASHMAP_H_
+#define CXA_HASHMAP_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize the map with a declared array of entries
+ *
+ * @code
+ * cxa_hashMap_t myMap;
+ * cxa_hashMap_entry_t myEntries[32];
+ *
+ * cxa_hashMap_initStd(&myMap, CXA_HASHMAP_KEYTYPE_INT, myEntries);
+ * // equivalent to
+ * cxa_hashMap_init(&myMap, CXA_HASHMAP_KEYTYPE_INT, myEntries, sizeof(myEntries));
+ * @endcode
+ *
+ * @param[in] mapIn pointer to the map to initialize
+ * @param[in] keyTypeIn the type of key used by this map
+ * @param[in] entriesIn pointer to the declared c-style array of ::cxa_hashMap_entry_t
+ */
+#define cxa_hashMap_initStd(mapIn, keyTypeIn, entriesIn)						cxa_hashMap_init((mapIn), (keyTypeIn), (entriesIn), sizeof(entriesIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_hashMap_t object
+ */
+typedef struct cxa_hashMap cxa_hashMap_t;
+
+
+/**
+ * @public
+ * The type of key used by a map
+ */
+typedef enum
+{
+	CXA_HASHMAP_KEYTYPE_INT,			//!< keys are uint32_t (use the *_int functions)
+	CXA_HASHMAP_KEYTYPE_STRING			//!< keys are null-terminated strings (use the *_str functions)
+}cxa_hashMap_keyType_t;
+
+
+/**
+ * @public
+ * @brief A single slot in the map. Users must declare an array of these
+ * (but should not access their contents directly).
+ */
+typedef struct
+{
+	union
+	{
+		uint32_t intVal;
+		const char* strVal;
+	}key;
+	void* value;
+
+	uint32_t hash;
+	uint16_t probeLen;				// 0 if empty, otherwise distance from home slot + 1
+}cxa_hashMap_entry_t;
+
+
+/**
+ * @private
+ */
+struct cxa_hashMap
+{
+	cxa_hashMap_keyType_t keyType;
+
+	cxa_hashMap_entry_t* entries;
+	size_t maxNumEntries;
+	size_t numEntries;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the map (empty) using the specified entry buffer
+ *
+ * @param[in] mapIn pointer to the pre-allocated cxa_hashMap_t object
+ * @param[in] keyTypeIn the type of key used by this map
+ * @param[in] entriesIn pointer to the pre-allocated entry buffer
+ * @param[in] entriesSize_bytesIn the size of the entry buffer in bytes
+ */
+void cxa_hashMap_init(cxa_hashMap_t *const mapIn, cxa_hashMap_keyType_t keyTypeIn, cxa_hashMap_entry_t *const entriesIn, const size_t entriesSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Removes all entries from the map
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object
+ */
+void cxa_hashMap_clear(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Adds an entry to the map (or replaces the value of an existing entry)
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_INT)
+ * @param[in] keyIn the key
+ * @param[in] valueIn the value to associate with the key
+ *
+ * @return true on success, false if the key is new and the map is full
+ */
+bool cxa_hashMap_put_int(cxa_hashMap_t *const mapIn, uint32_t keyIn, void *const valueIn);
+
+
+/**
+ * @public
+ * @brief Looks up the value associated with the specified key
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_INT)
+ * @param[in] keyIn the key
+ * @param[out] valueOut set to the value associated with the key (if found).
+ * 		May be NULL if only the presence of the key is of interest.
+ *
+ * @return true if the key was found
+ */
+bool cxa_hashMap_get_int(cxa_hashMap_t *const mapIn, uint32_t keyIn, void **const valueOut);
+
+
+/**
+ * @public
+ * @brief Removes the entry with the specified key
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_INT)
+ * @param[in] keyIn the key
+ *
+ * @return true if the key was found (and removed)
+ */
+bool cxa_hashMap_remove_int(cxa_hashMap_t *const mapIn, uint32_t keyIn);
+
+
+/**
+ * @public
+ * @brief Adds an entry to the map (or replaces the value of an existing entry)
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_STRING)
+ * @param[in] keyIn the null-terminated key (NOT copied)
+ * @param[in] valueIn the value to associate with the key
+ *
+ * @return true on success, false if the key is new and the map is full
+ */
+bool cxa_hashMap_put_str(cxa_hashMap_t *const mapIn, const char *const keyIn, void *const valueIn);
+
+
+/**
+ * @public
+ * @brief Looks up the value associated with the specified key
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_STRING)
+ * @param[in] keyIn the null-terminated key
+ * @param[out] valueOut set to the value associated with the key (if found).
+ * 		May be NULL if only the presence of the key is of interest.
+ *
+ * @return true if the key was found
+ */
+bool cxa_hashMap_get_str(cxa_hashMap_t *const mapIn, const char *const keyIn, void **const valueOut);
+
+
+/**
+ * @public
+ * @brief Removes the entry with the specified key
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object (::CXA_HASHMAP_KEYTYPE_STRING)
+ * @param[in] keyIn the null-terminated key
+ *
+ * @return true if the key was found (and removed)
+ */
+bool cxa_hashMap_remove_str(cxa_hashMap_t *const mapIn, const char *const keyIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of entries in the map
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object
+ *
+ * @return the number of entries in the map
+ */
+size_t cxa_hashMap_getSize_elems(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Determines the maximum number of entries the map can hold
+ *
+ * @param[in] mapIn pointer to the pre-initialized map object
+ *
+ * @return the maximum number of entries the map can hold
+ */
+size_t cxa_hashMap_getMaxSize_elems(cxa_hashMap_t *const mapIn);
+
+
+#endif // CXA_HASHMAP_H_
@@ -0,0 +1,203 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-max-length,
+ * multi-producer / multi-consumer queue holding elements of a single datatype (and size).
+ * Any number of threads may queue and dequeue concurrently without a lock: each slot
+ * carries a sequence number which tells producers when it is free and consumers when
+ * it is full, so the only shared writes are a single compare-and-swap on the enqueue
+ * or dequeue position (which are kept on separate cache lines).
+ *
+ * Like ::cxa_fixedFifo_t, the queue does not hold any data itself. Elements are stored
+ * in an external buffer (and the per-slot sequence numbers in a second, parallel buffer)
+ * supplied during initialization. The number of elements must be a power of 2.
+ *
+ * @note This object requires C11 atomics (`stdatomic.h`)
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_mpmcQueue_t myQueue;
+ * myMsg_t myQueue_buffer[16];
+ * cxa_mpmcQueue_seq_t myQueue_seqs[16];
+ *
+ * cxa_mpmcQueue_initStd(&myQueue, myQueue_buffer, myQueue_seqs);
+ *
+ * // from any thread
+ * myMsg_t newMsg = {...};
+ * if( !cxa_mpmcQueue_queue(&myQueue, &newMsg) ) { ...queue was full... }
+ *
+ * // from any other thread
+ * myMsg_t rxMsg;
+ * while( cxa_mpmcQueue_dequeue(&myQueue, &rxMsg) ) { ... }
+ * @endcode
+ */
+#ifndef CXA_MPMCQUEUE_H_
+#define CXA_MPMCQUEUE_H_
+
+
+// ******** includes ********
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * The size (in bytes) of a cache line on the target. Used to keep the
+ * enqueue and dequeue positions from sharing a cache line.
+ */
+#ifndef CXA_MPMCQUEUE_CACHELINE_SIZE
+	#define CXA_MPMCQUEUE_CACHELINE_SIZE		64
+#endif
+
+
+/**
+ * @public
+ * @brief Shortcut to initialize the queue with buffers of an explicit data type
+ *
+ * @code
+ * cxa_mpmcQueue_t myQueue;
+ * double myBuffer[16];
+ * cxa_mpmcQueue_seq_t mySeqs[16];
+ *
+ * cxa_mpmcQueue_initStd(&myQueue, myBuffer, mySeqs);
+ * // equivalent to
+ * cxa_mpmcQueue_init(&myQueue, sizeof(*myBuffer), (void*)myBuffer, sizeof(myBuffer), mySeqs, sizeof(mySeqs));
+ * @endcode
+ *
+ * @param[in] queueIn pointer to queue to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which will contain
+ * 		the data for the queue
+ * @param[in] seqsIn pointer to the declared c-style array of ::cxa_mpmcQueue_seq_t
+ * 		(with the same number of elements as bufferIn)
+ */
+#define cxa_mpmcQueue_initStd(queueIn, bufferIn, seqsIn)						cxa_mpmcQueue_init((queueIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn), (seqsIn), sizeof(seqsIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_mpmcQueue_t object
+ */
+typedef struct cxa_mpmcQueue cxa_mpmcQueue_t;
+
+
+/**
+ * @public
+ * @brief Per-slot sequence number. Users must declare an array of these
+ * with the same number of elements as the queue's buffer.
+ */
+typedef struct
+{
+	atomic_size_t sequence;
+}cxa_mpmcQueue_seq_t;
+
+
+/**
+ * @private
+ */
+struct cxa_mpmcQueue
+{
+	void *bufferLoc;
+	cxa_mpmcQueue_seq_t *seqs;
+
+	size_t datatypeSize_bytes;
+	size_t indexMask;
+
+	_Alignas(CXA_MPMCQUEUE_CACHELINE_SIZE) atomic_size_t enqueuePos;
+	_Alignas(CXA_MPMCQUEUE_CACHELINE_SIZE) atomic_size_t dequeuePos;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the queue using the specified buffers (which are empty)
+ *
+ * @param[in] queueIn pointer to the pre-allocated cxa_mpmcQueue_t object
+ * @param[in] datatypeSize_bytesIn the size of each element that will be inserted
+ * 		into the queue (all elements MUST be the same size)
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will
+ * 		be used to store elements in the queue
+ * @param[in] bufferMaxSize_bytesIn the size of the buffer in bytes. Must hold
+ * 		a power-of-2 number of elements.
+ * @param[in] seqsIn pointer to the pre-allocated per-slot sequence numbers
+ * @param[in] seqsSize_bytesIn the size of the sequence number buffer in bytes.
+ * 		Must hold the same number of entries as the element buffer.
+ */
+void cxa_mpmcQueue_init(cxa_mpmcQueue_t *const queueIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						cxa_mpmcQueue_seq_t *const seqsIn, const size_t seqsSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Queues an element. May be called from any thread.
+ *
+ * @param[in] queueIn pointer to the pre-initialized queue object
+ * @param[in] elemIn pointer to the element which will be copied
+ * 		into the queue's buffer
+ *
+ * @return true if the element was queued, false if the queue was full
+ */
+bool cxa_mpmcQueue_queue(cxa_mpmcQueue_t *const queueIn, void *const elemIn);
+
+
+/**
+ * @public
+ * @brief Dequeues an element. May be called from any thread.
+ *
+ * @param[in] queueIn pointer to the pre-initialized queue object
+ * @param[out] elemOut pointer to where the element should be copied. May be
+ * 		NULL if no copy is desired.
+ *
+ * @return true if an element was dequeued, false if the queue was empty
+ */
+bool cxa_mpmcQueue_dequeue(cxa_mpmcQueue_t *const queueIn, void *elemOut);
+
+
+/**
+ * @public
+ * @brief Determines the number of elements in the queue. If other threads
+ * are queueing / dequeueing concurrently, this is only a snapshot.
+ *
+ * @param[in] queueIn pointer to the pre-initialized queue object
+ *
+ * @return the number of elements in the queue
+ */
+size_t cxa_mpmcQueue_getSize_elems(cxa_mpmcQueue_t *const queueIn);
+
+
+/**
+ * @public
+ * @brief Determines the maximum number of elements in the queue.
+ *
+ * @param[in] queueIn pointer to the pre-initialized queue object
+ *
+ * @return the maximum number of the elements the queue can hold
+ */
+size_t cxa_mpmcQueue_getMaxSize_elems(cxa_mpmcQueue_t *const queueIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the queue is empty. If other threads are
+ * queueing / dequeueing concurrently, this is only a snapshot.
+ *
+ * @param[in] queueIn pointer to the pre-initialized queue object
+ *
+ * @return true if the queue does not currently contain any elements
+ */
+bool cxa_mpmcQueue_isEmpty(cxa_mpmcQueue_t *const queueIn);
+
+
+#endif // CXA_MPMCQUEUE_H_
@@ -0,0 +1,249 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated pool of objects of a
+ * single datatype (and size). Free objects are kept on a free list so that reserving
+ * and releasing an object are O(1) regardless of the size of the pool. Since all objects
+ * live in one contiguous buffer, finding the slot for a given object pointer is O(1) as well.
+ *
+ * The free list and per-object reference counts are stored in a second, parallel buffer
+ * (rather than inside the objects themselves) so that the contents of a released object
+ * are left untouched. This allows one-time setup (eg. initializing an embedded
+ * ::cxa_fixedByteBuffer_t) to be done once, when the pool is created.
+ *
+ * @note This object is NOT thread-safe
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_objectPool_t myPool;
+ * myMsg_t myPool_buffer[64];
+ * cxa_objectPool_slot_t myPool_slots[64];
+ *
+ * cxa_objectPool_initStd(&myPool, myPool_buffer, myPool_slots);
+ *
+ * myMsg_t* msg = (myMsg_t*)cxa_objectPool_reserve(&myPool);		// refCount is 1
+ * cxa_objectPool_retain(&myPool, msg);							// refCount is 2
+ * ...
+ * cxa_objectPool_release(&myPool, msg);							// refCount is 1
+ * cxa_objectPool_release(&myPool, msg);							// back in the pool
+ * @endcode
+ */
+#ifndef CXA_OBJECTPOOL_H_
+#define CXA_OBJECTPOOL_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize the pool with buffers of an explicit data type
+ *
+ * @code
+ * cxa_objectPool_t myPool;
+ * myObj_t myBuffer[16];
+ * cxa_objectPool_slot_t mySlots[16];
+ *
+ * cxa_objectPool_initStd(&myPool, myBuffer, mySlots);
+ * // equivalent to
+ * cxa_objectPool_init(&myPool, sizeof(*myBuffer), (void*)myBuffer, sizeof(myBuffer), mySlots, sizeof(mySlots));
+ * @endcode
+ *
+ * @param[in] poolIn pointer to the pool to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which will contain
+ * 		the objects of the pool
+ * @param[in] slotsIn pointer to the declared c-style array of ::cxa_objectPool_slot_t
+ * 		(with the same number of elements as bufferIn)
+ */
+#define cxa_objectPool_initStd(poolIn, bufferIn, slotsIn)						cxa_objectPool_init((poolIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn), (slotsIn), sizeof(slotsIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_objectPool_t object
+ */
+typedef struct cxa_objectPool cxa_objectPool_t;
+
+
+/**
+ * @public
+ * @brief Per-object bookkeeping. Users must declare an array of these
+ * with the same number of elements as the pool's buffer.
+ */
+typedef struct
+{
+	size_t nextFreeIndex;
+	uint8_t refCount;
+}cxa_objectPool_slot_t;
+
+
+/**
+ * @private
+ */
+struct cxa_objectPool
+{
+	void *bufferLoc;
+	cxa_objectPool_slot_t *slots;
+
+	size_t datatypeSize_bytes;
+	size_t maxNumElements;
+
+	size_t freeHeadIndex;
+	size_t numInUse;
+	size_t highWatermark;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the pool using the specified buffers. All objects
+ * start out free.
+ *
+ * @param[in] poolIn pointer to the pre-allocated cxa_objectPool_t object
+ * @param[in] datatypeSize_bytesIn the size of each object in the pool
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that
+ * 		holds the objects
+ * @param[in] bufferMaxSize_bytesIn the size of the object buffer in bytes
+ * @param[in] slotsIn pointer to the pre-allocated per-object bookkeeping
+ * @param[in] slotsSize_bytesIn the size of the bookkeeping buffer in bytes.
+ * 		Must hold the same number of entries as the object buffer.
+ */
+void cxa_objectPool_init(cxa_objectPool_t *const poolIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						 cxa_objectPool_slot_t *const slotsIn, const size_t slotsSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief Reserves a free object from the pool (with a reference count of 1).
+ * The contents of the object are whatever they were when it was last released.
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ *
+ * @return pointer to the reserved object, or NULL if the pool is exhausted
+ */
+void* cxa_objectPool_reserve(cxa_objectPool_t *const poolIn);
+
+
+/**
+ * @public
+ * @brief Increments the reference count of a reserved object
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] objIn pointer to a reserved object within the pool
+ */
+void cxa_objectPool_retain(cxa_objectPool_t *const poolIn, void *const objIn);
+
+
+/**
+ * @public
+ * @brief Decrements the reference count of a reserved object. When the
+ * reference count reaches 0, the object is returned to the pool.
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] objIn pointer to an object within the pool
+ *
+ * @return false if the object was not reserved (mismatched release), otherwise true
+ */
+bool cxa_objectPool_release(cxa_objectPool_t *const poolIn, void *const objIn);
+
+
+/**
+ * @public
+ * @brief Determines the reference count of the specified object
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] objIn pointer to an object within the pool
+ *
+ * @return the reference count of the object (0 if it is free)
+ */
+uint8_t cxa_objectPool_getRefCount(cxa_objectPool_t *const poolIn, void *const objIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the specified pointer refers to an object
+ * within this pool (reserved or not)
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] ptrIn the pointer to check
+ *
+ * @return true if the pointer is the address of one of the pool's objects
+ */
+bool cxa_objectPool_contains(cxa_objectPool_t *const poolIn, void *const ptrIn);
+
+
+/**
+ * @public
+ * @brief Determines the index of the specified object within the pool
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] objIn pointer to an object within the pool
+ *
+ * @return the index of the object
+ */
+size_t cxa_objectPool_getIndex(cxa_objectPool_t *const poolIn, void *const objIn);
+
+
+/**
+ * @public
+ * @brief Returns the object at the specified index (reserved or not)
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ * @param[in] indexIn the index of the object (must be less than
+ * 		::cxa_objectPool_getMaxSize_elems)
+ *
+ * @return pointer to the object
+ */
+void* cxa_objectPool_getObject_atIndex(cxa_objectPool_t *const poolIn, size_t indexIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of free objects in the pool
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ *
+ * @return the number of objects which may still be reserved
+ */
+size_t cxa_objectPool_getNumFree_elems(cxa_objectPool_t *const poolIn);
+
+
+/**
+ * @public
+ * @brief Determines the total number of objects in the pool
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ *
+ * @return the total number of objects in the pool
+ */
+size_t cxa_objectPool_getMaxSize_elems(cxa_objectPool_t *const poolIn);
+
+
+/**
+ * @public
+ * @brief Determines the maximum number of objects that have been reserved
+ * at the same time since the pool was initialized. Useful for sizing pools.
+ *
+ * @param[in] poolIn pointer to the pre-initialized pool object
+ *
+ * @return the high watermark, in number of objects
+ */
+size_t cxa_objectPool_getHighWatermark_elems(cxa_objectPool_t *const poolIn);
+
+
+#endif // CXA_OBJECTPOOL_H_
@@ -0,0 +1,137 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains a generator for statically allocated, fixed-max-length arrays
+ * of a specific datatype. Unlike ::cxa_array_t (which stores the element size at runtime
+ * and moves elements through a `void*` with `memcpy`), the element type and capacity
+ * of a generated array are known at compile time and all accessors are `static inline`.
+ * This lets the compiler turn element copies into plain assignments and optimize
+ * iteration, which matters for small arrays in hot paths (eg. listener lists).
+ *
+ * The generated accessors do not assert...out-of-range accesses are reported via
+ * their return values, matching the semantics of the equivalent ::cxa_array_t function.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * typedef struct
+ * {
+ *    cb_onEvent_t cb;
+ *    void* userVar;
+ * }listener_t;
+ *
+ * // generates listenerArray_t, listenerArray_init, listenerArray_append, etc
+ * CXA_ARRAY_DEFINE(listenerArray, listener_t, 4)
+ *
+ * listenerArray_t myListeners;
+ * listenerArray_init(&myListeners);
+ *
+ * listener_t newListener = {.cb=myCb, .userVar=NULL};
+ * listenerArray_append(&myListeners, &newListener);
+ *
+ * cxa_typedArray_iterate(&myListeners, currListener, listener_t)
+ * {
+ *    currListener->cb(currListener->userVar);
+ * }
+ * @endcode
+ */
+#ifndef CXA_TYPEDARRAY_H_
+#define CXA_TYPEDARRAY_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Iterates over all elements of a generated array
+ *
+ * @param[in] arrIn pointer to the generated array
+ * @param[in] varNameIn the name of the loop variable (a pointer to the current element)
+ * @param[in] elemTypeIn the element type of the array
+ */
+#define cxa_typedArray_iterate(arrIn, varNameIn, elemTypeIn)		for( elemTypeIn* (varNameIn) = (arrIn)->elems; (varNameIn) < &(arrIn)->elems[(arrIn)->numElems]; (varNameIn)++ )
+
+
+/**
+ * @public
+ * @brief Generates a typed, fixed-capacity array named `<nameIn>_t` along with
+ * `static inline` accessors prefixed with `<nameIn>_`:
+ *
+ * - `void <name>_init(<name>_t*)`
+ * - `void <name>_clear(<name>_t*)`
+ * - `bool <name>_append(<name>_t*, const elemType*)`: false if full
+ * - `elemType* <name>_append_empty(<name>_t*)`: NULL if full
+ * - `elemType* <name>_get(<name>_t*, size_t)`: NULL if out of range
+ * - `bool <name>_remove_atIndex(<name>_t*, size_t)`: false if out of range
+ * - `size_t <name>_getSize_elems(<name>_t*)`
+ * - `size_t <name>_getMaxSize_elems(<name>_t*)`
+ * - `bool <name>_isEmpty(<name>_t*)` / `bool <name>_isFull(<name>_t*)`
+ *
+ * @param[in] nameIn the name of the generated type (and prefix of its functions)
+ * @param[in] elemTypeIn the element type
+ * @param[in] maxNumElemsIn the capacity of the array
+ */
+#define CXA_ARRAY_DEFINE(nameIn, elemTypeIn, maxNumElemsIn)																\
+	typedef struct																										\
+	{																													\
+		elemTypeIn elems[(maxNumElemsIn)];																				\
+		size_t numElems;																								\
+	}nameIn##_t;																										\
+																														\
+	static inline void nameIn##_init(nameIn##_t *const arrIn) { arrIn->numElems = 0; }								\
+	static inline void nameIn##_clear(nameIn##_t *const arrIn) { arrIn->numElems = 0; }								\
+	static inline size_t nameIn##_getSize_elems(nameIn##_t *const arrIn) { return arrIn->numElems; }					\
+	static inline size_t nameIn##_getMaxSize_elems(nameIn##_t *const arrIn) { (void)arrIn; return (maxNumElemsIn); }	\
+	static inline bool nameIn##_isEmpty(nameIn##_t *const arrIn) { return (arrIn->numElems == 0); }					\
+	static inline bool nameIn##_isFull(nameIn##_t *const arrIn) { return (arrIn->numElems >= (maxNumElemsIn)); }		\
+																														\
+	static inline elemTypeIn* nameIn##_append_empty(nameIn##_t *const arrIn)											\
+	{																													\
+		if( arrIn->numElems >= (maxNumElemsIn) ) return NULL;															\
+		return &arrIn->elems[arrIn->numElems++];																		\
+	}																													\
+																														\
+	static inline bool nameIn##_append(nameIn##_t *const arrIn, const elemTypeIn *const elemIn)						\
+	{																													\
+		elemTypeIn* newElem = nameIn##_append_empty(arrIn);																\
+		if( newElem == NULL ) return false;																				\
+		*newElem = *elemIn;																								\
+		return true;																									\
+	}																													\
+																														\
+	static inline elemTypeIn* nameIn##_get(nameIn##_t *const arrIn, const size_t indexIn)								\
+	{																													\
+		return (indexIn < arrIn->numElems) ? &arrIn->elems[indexIn] : NULL;												\
+	}																													\
+																														\
+	static inline bool nameIn##_remove_atIndex(nameIn##_t *const arrIn, const size_t indexIn)							\
+	{																													\
+		if( indexIn >= arrIn->numElems ) return false;																	\
+		memmove(&arrIn->elems[indexIn], &arrIn->elems[indexIn+1], (arrIn->numElems - indexIn - 1) * sizeof(elemTypeIn));	\
+		arrIn->numElems--;																								\
+		return true;																									\
+	}
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+
+
+#endif // CXA_TYPEDARRAY_H_
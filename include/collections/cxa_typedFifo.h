@@ -0,0 +1,122 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains a generator for statically allocated, fixed-max-length FIFOs
+ * of a specific datatype. Unlike ::cxa_fixedFifo_t (which stores the element size at
+ * runtime and moves elements through a `void*` with `memcpy`), the element type and
+ * capacity of a generated FIFO are known at compile time and all accessors are
+ * `static inline`. Queueing a `uint8_t` compiles down to a store and an index update.
+ *
+ * Generated FIFOs always drop new elements when full (equivalent to
+ * ::CXA_FF_ON_FULL_DROP) and do not support listeners. Use ::cxa_fixedFifo_t
+ * when those are needed.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * // generates byteFifo_t, byteFifo_init, byteFifo_queue, etc
+ * CXA_FIFO_DEFINE(byteFifo, uint8_t, 64)
+ *
+ * byteFifo_t rxFifo;
+ * byteFifo_init(&rxFifo);
+ *
+ * byteFifo_queue(&rxFifo, &rxByte);
+ * ...
+ * uint8_t currByte;
+ * while( byteFifo_dequeue(&rxFifo, &currByte) ) { ... }
+ * @endcode
+ */
+#ifndef CXA_TYPEDFIFO_H_
+#define CXA_TYPEDFIFO_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdlib.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Generates a typed, fixed-capacity FIFO named `<nameIn>_t` along with
+ * `static inline` accessors prefixed with `<nameIn>_`:
+ *
+ * - `void <name>_init(<name>_t*)`
+ * - `void <name>_clear(<name>_t*)`
+ * - `bool <name>_queue(<name>_t*, const elemType*)`: false if full
+ * - `bool <name>_dequeue(<name>_t*, elemType*)`: false if empty (out may be NULL)
+ * - `elemType* <name>_peek(<name>_t*)`: NULL if empty
+ * - `size_t <name>_getSize_elems(<name>_t*)`
+ * - `size_t <name>_getMaxSize_elems(<name>_t*)`
+ * - `bool <name>_isEmpty(<name>_t*)` / `bool <name>_isFull(<name>_t*)`
+ *
+ * @param[in] nameIn the name of the generated type (and prefix of its functions)
+ * @param[in] elemTypeIn the element type
+ * @param[in] maxNumElemsIn the capacity of the FIFO
+ */
+#define CXA_FIFO_DEFINE(nameIn, elemTypeIn, maxNumElemsIn)																\
+	typedef struct																										\
+	{																													\
+		elemTypeIn elems[(maxNumElemsIn)+1];																			\
+		size_t insertIndex;																								\
+		size_t removeIndex;																								\
+	}nameIn##_t;																										\
+																														\
+	static inline size_t nameIn##_nextIndex(const size_t indexIn)														\
+	{																													\
+		return ((indexIn + 1) >= ((maxNumElemsIn)+1)) ? 0 : (indexIn + 1);												\
+	}																													\
+																														\
+	static inline void nameIn##_init(nameIn##_t *const fifoIn) { fifoIn->insertIndex = 0; fifoIn->removeIndex = 0; }	\
+	static inline void nameIn##_clear(nameIn##_t *const fifoIn) { fifoIn->insertIndex = 0; fifoIn->removeIndex = 0; }	\
+	static inline size_t nameIn##_getMaxSize_elems(nameIn##_t *const fifoIn) { (void)fifoIn; return (maxNumElemsIn); }	\
+	static inline bool nameIn##_isEmpty(nameIn##_t *const fifoIn) { return (fifoIn->insertIndex == fifoIn->removeIndex); }	\
+	static inline bool nameIn##_isFull(nameIn##_t *const fifoIn) { return (nameIn##_nextIndex(fifoIn->insertIndex) == fifoIn->removeIndex); }	\
+																														\
+	static inline size_t nameIn##_getSize_elems(nameIn##_t *const fifoIn)												\
+	{																													\
+		return (fifoIn->insertIndex >= fifoIn->removeIndex) ?															\
+				(fifoIn->insertIndex - fifoIn->removeIndex) :															\
+				(((maxNumElemsIn)+1) - fifoIn->removeIndex + fifoIn->insertIndex);										\
+	}																													\
+																														\
+	static inline bool nameIn##_queue(nameIn##_t *const fifoIn, const elemTypeIn *const elemIn)						\
+	{																													\
+		size_t newInsertIndex = nameIn##_nextIndex(fifoIn->insertIndex);												\
+		if( newInsertIndex == fifoIn->removeIndex ) return false;														\
+		fifoIn->elems[fifoIn->insertIndex] = *elemIn;																	\
+		fifoIn->insertIndex = newInsertIndex;																			\
+		return true;																									\
+	}																													\
+																														\
+	static inline elemTypeIn* nameIn##_peek(nameIn##_t *const fifoIn)													\
+	{																													\
+		return (fifoIn->insertIndex == fifoIn->removeIndex) ? NULL : &fifoIn->elems[fifoIn->removeIndex];				\
+	}																													\
+																														\
+	static inline bool nameIn##_dequeue(nameIn##_t *const fifoIn, elemTypeIn *const elemOut)							\
+	{																													\
+		if( fifoIn->insertIndex == fifoIn->removeIndex ) return false;													\
+		if( elemOut != NULL ) *elemOut = fifoIn->elems[fifoIn->removeIndex];											\
+		fifoIn->removeIndex = nameIn##_nextIndex(fifoIn->removeIndex);													\
+		return true;																									\
+	}
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+
+
+#endif // CXA_TYPEDFIFO_H_
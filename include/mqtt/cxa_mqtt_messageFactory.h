@@ -23,6 +23,12 @@
 	#define CXA_MQTT_MESSAGEFACTORY_MESSAGE_SIZE_BYTES		64
 #endif
 
+// additional bytes per message reserved so topic name prepends don't have to
+// shift the payload (costs NUM_MESSAGES * HEADROOM bytes of RAM, opt-in)
+#ifndef CXA_MQTT_MESSAGEFACTORY_MESSAGE_HEADROOM_BYTES
+	#define CXA_MQTT_MESSAGEFACTORY_MESSAGE_HEADROOM_BYTES	0
+#endif
+
 
 // ******** global type definitions *********
 
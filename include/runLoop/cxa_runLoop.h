@@ -11,16 +11,138 @@
 // ******** includes ********
 #include <stdbool.h>
 #include <stdint.h>
+#include <cxa_arena.h>
 #include <cxa_config.h>
 
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	#include <cxa_ioStream.h>
+#endif
+
 
 // ******** global macro definitions ********
+/**
+ * @public
+ * Maximum number of entries per thread. Each thread owns its own entry
+ * table so memory scales with CXA_RUNLOOP_MAXNUM_THREADS.
+ */
 #ifndef CXA_RUNLOOP_MAXNUM_ENTRIES
 	#define CXA_RUNLOOP_MAXNUM_ENTRIES				10
 #endif
 
+/**
+ * @public
+ * Define CXA_RUNLOOP_MULTITHREAD_ENABLE in your cxa_config.h if the run
+ * loop is iterated with more than one threadId. It raises the defaults
+ * of CXA_RUNLOOP_MAXNUM_THREADS and CXA_RUNLOOP_CACHELINE_SIZE so that
+ * every target doesn't pay for contexts (and padding) only multithreaded
+ * builds use.
+ */
+
+/**
+ * @public
+ * Maximum number of distinct threadIds which may be passed to the run loop.
+ * The first call with a new threadId claims a context (each holding its
+ * own CXA_RUNLOOP_MAXNUM_ENTRIES entries); exceeding this asserts.
+ * Defaults to 1, or 4 with CXA_RUNLOOP_MULTITHREAD_ENABLE.
+ */
+#ifndef CXA_RUNLOOP_MAXNUM_THREADS
+	#ifdef CXA_RUNLOOP_MULTITHREAD_ENABLE
+		#define CXA_RUNLOOP_MAXNUM_THREADS			4
+	#else
+		#define CXA_RUNLOOP_MAXNUM_THREADS			1
+	#endif
+#endif
+
+/**
+ * @public
+ * When > 0, per-thread scheduling state is aligned to this boundary so
+ * threads don't contend for the same cache lines. Defaults to 0 (no
+ * padding), or 64 with CXA_RUNLOOP_MULTITHREAD_ENABLE.
+ */
+#ifndef CXA_RUNLOOP_CACHELINE_SIZE
+	#ifdef CXA_RUNLOOP_MULTITHREAD_ENABLE
+		#define CXA_RUNLOOP_CACHELINE_SIZE			64
+	#else
+		#define CXA_RUNLOOP_CACHELINE_SIZE			0
+	#endif
+#endif
+
+/**
+ * @public
+ * Number of slots in each thread's lock-free inbox (a ::cxa_mpmcQueue_t,
+ * so it must be a power of 2). When > 0, ::cxa_runLoop_dispatchNextIteration
+ * and ::cxa_runLoop_dispatchAfter may be called from any thread (requires
+ * C11 atomics). This is also the maximum number of outstanding dispatches
+ * per thread.
+ */
+#ifndef CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES
+	#define CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES		0
+#endif
+
+/**
+ * @public
+ * Maximum number of file descriptor sources per thread (POSIX only).
+ * Leave at 0 to compile out ::cxa_runLoop_addFdSource.
+ */
+#ifndef CXA_RUNLOOP_MAXNUM_FDSOURCES
+	#define CXA_RUNLOOP_MAXNUM_FDSOURCES			0
+#endif
+
+/**
+ * @public
+ * Maximum number of end-of-iteration callbacks per thread
+ * (see ::cxa_runLoop_addEndOfIterationCb)
+ */
+#ifndef CXA_RUNLOOP_MAXNUM_ENDOFITERATION_CBS
+	#define CXA_RUNLOOP_MAXNUM_ENDOFITERATION_CBS	4
+#endif
+
 #define CXA_RUNLOOP_THREADID_DEFAULT				0
 
+/**
+ * @public
+ * Define CXA_RUNLOOP_TICKLESS_ENABLE in your cxa_config.h (POSIX only) to
+ * have ::cxa_runLoop_execute sleep until the next entry is due (or until
+ * ::cxa_runLoop_wakeup is called) instead of spinning on
+ * ::cxa_runLoop_iterate.
+ */
+
+/**
+ * @public
+ * Define CXA_RUNLOOP_WORKERPOOL_ENABLE in your cxa_config.h (POSIX only)
+ * to run entries added with ::cxa_runLoop_addIndependentEntry in parallel
+ * on a pool of CXA_RUNLOOP_WORKERPOOL_NUM_WORKERS threads (per run loop
+ * thread). All other entries keep running serially, in order, on the
+ * run loop's own thread.
+ */
+#ifndef CXA_RUNLOOP_WORKERPOOL_NUM_WORKERS
+	#define CXA_RUNLOOP_WORKERPOOL_NUM_WORKERS		4
+#endif
+
+/**
+ * @public
+ * Define CXA_RUNLOOP_PROFILER_ENABLE in your cxa_config.h to record
+ * per-entry execution statistics (see ::cxa_runLoop_profiler_getProfile).
+ * Compiles to nothing when not defined.
+ */
+
+/**
+ * @public
+ * Number of buckets in each entry's execution time histogram. Bucket 0
+ * counts calls which took <1us, bucket n counts [2^(n-1), 2^n) us and the
+ * last bucket also counts everything longer.
+ */
+#ifndef CXA_RUNLOOP_PROFILER_NUM_BUCKETS
+	#define CXA_RUNLOOP_PROFILER_NUM_BUCKETS		16
+#endif
+
+/**
+ * @public
+ * Returned by ::cxa_runLoop_getTimeUntilNextDeadline_us when the
+ * thread has no entries scheduled to run
+ */
+#define CXA_RUNLOOP_NO_DEADLINE						UINT32_MAX
+
 
 // ******** global type definitions *********
 /**
@@ -29,16 +151,280 @@
 typedef void (*cxa_runLoop_cb_t)(void* userVarIn);
 
 
+/**
+ * @public
+ * Within an iteration, all entries of a higher priority run before those
+ * of a lower priority. Due timed entries of the same priority run
+ * most-overdue first.
+ */
+typedef enum
+{
+	CXA_RUNLOOP_PRIORITY_HIGH,
+	CXA_RUNLOOP_PRIORITY_NORMAL,
+	CXA_RUNLOOP_PRIORITY_LOW
+}cxa_runLoop_priority_t;
+
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+/**
+ * @public
+ * Readiness events for ::cxa_runLoop_addFdSource (may be OR'd together)
+ */
+typedef enum
+{
+	CXA_RUNLOOP_FDEVENT_READABLE = 0x01,
+	CXA_RUNLOOP_FDEVENT_WRITABLE = 0x02,
+	CXA_RUNLOOP_FDEVENT_ERROR = 0x04				//!< reported only, always monitored
+}cxa_runLoop_fdEvent_t;
+
+
+/**
+ * @public
+ * @brief Called from the run loop when a file descriptor is ready
+ *
+ * @param[in] fdIn the file descriptor which is ready
+ * @param[in] eventsIn the ::cxa_runLoop_fdEvent_t flags which are pending
+ * @param[in] userVarIn the user variable passed to ::cxa_runLoop_addFdSource
+ */
+typedef void (*cxa_runLoop_cb_fdReady_t)(int fdIn, int eventsIn, void* userVarIn);
+#endif
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+/**
+ * @public
+ * Execution statistics for a single run loop entry
+ */
+typedef struct
+{
+	cxa_runLoop_cb_t updateCb;
+	void* userVar;
+	uint32_t execPeriod_ms;							//!< 0 for untimed entries
+
+	uint32_t numCalls;
+	uint64_t totalExecTime_us;
+	uint32_t maxExecTime_us;
+	uint32_t histogram[CXA_RUNLOOP_PROFILER_NUM_BUCKETS];
+
+	uint64_t totalLateness_us;						//!< timed entries only
+	uint32_t maxLateness_us;						//!< timed entries only
+	uint32_t numOverruns;							//!< calls which took longer than execPeriod_ms
+}cxa_runLoop_profile_t;
+#endif
+
+
 // ******** global function prototypes ********
 void cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
 void cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
 void cxa_runLoop_clearAllEntries(void);
 
-void cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
-void cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+/**
+ * @public
+ * @brief Same as ::cxa_runLoop_addEntry / ::cxa_runLoop_addTimedEntry
+ * (which use ::CXA_RUNLOOP_PRIORITY_NORMAL) but with the specified priority
+ */
+void cxa_runLoop_addEntry_withPriority(int threadIdIn, cxa_runLoop_priority_t priorityIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+void cxa_runLoop_addTimedEntry_withPriority(int threadIdIn, cxa_runLoop_priority_t priorityIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Returns the time (see ::cxa_timeBase_getCount_ns) sampled once at
+ * the start of the specified thread's current (or most recent) iteration.
+ * Entries should prefer this to sampling the timeBase themselves.
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ *
+ * @return the iteration's start time, or the current time if the thread
+ * 		hasn't iterated yet
+ */
+uint64_t cxa_runLoop_getIterationTime_ns(int threadIdIn);
+
+/**
+ * @public
+ * @brief Sets the amount of time the specified thread may spend per
+ * iteration before ::CXA_RUNLOOP_PRIORITY_LOW entries are deferred to the
+ * next iteration. Low priority entries are never deferred two iterations
+ * in a row so they can't be starved.
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ * @param[in] budget_usIn the budget in microseconds, 0 (default) for no budget
+ */
+void cxa_runLoop_setIterationBudget_us(int threadIdIn, uint32_t budget_usIn);
+
+/**
+ * @public
+ * @brief Associates a scratch arena with the specified thread. The arena is
+ * reset at the end of every iteration of that thread so entries may make
+ * transient allocations from it (see ::cxa_runLoop_getIterationArena)
+ * without freeing them. Allocations are only valid until the allocating
+ * callback returns to the run loop.
+ *
+ * @note Independent entries (which may run on worker threads) must NOT
+ * 		allocate from the iteration arena
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ * @param[in] arenaIn the pre-initialized arena, NULL (default) for none
+ */
+void cxa_runLoop_setIterationArena(int threadIdIn, cxa_arena_t *const arenaIn);
+
+/**
+ * @public
+ * @param[in] threadIdIn the id of the thread in question
+ *
+ * @return the arena set via ::cxa_runLoop_setIterationArena, or NULL if none
+ */
+cxa_arena_t* cxa_runLoop_getIterationArena(int threadIdIn);
+
+/**
+ * @public
+ * @brief Registers a callback which is called once at the end of every
+ * iteration of the specified thread, after all entries (and fd sources)
+ * have run but before the iteration arena is reset. Useful for work
+ * which should be batched across entries (eg. flushing buffered output).
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ * @param[in] cbIn the callback to call
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_runLoop_addEndOfIterationCb(int threadIdIn, cxa_runLoop_cb_t cbIn, void *const userVarIn);
+
+#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+/**
+ * @public
+ * @brief Adds an entry whose update callback does not depend on (or share
+ * unprotected state with) any other entry. It may run on a worker thread,
+ * concurrently with other entries, but always completes before the
+ * iteration which called it returns. The startup callback is still called
+ * from the run loop's thread.
+ *
+ * @param[in] threadIdIn the id of the thread which owns this entry
+ * @param[in] startupCbIn called once before the first update (may be NULL)
+ * @param[in] updateCbIn called every iteration
+ * @param[in] userVarIn user variable passed to the callbacks
+ */
+void cxa_runLoop_addIndependentEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Timed version of ::cxa_runLoop_addIndependentEntry
+ */
+void cxa_runLoop_addIndependentTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+#endif
+
+/**
+ * @public
+ * @brief Calls the specified callback once, on the next iteration of the
+ * specified thread (or, for ::cxa_runLoop_dispatchAfter, once the delay
+ * has elapsed)
+ *
+ * @param[in] threadIdIn the id of the thread which should call the callback
+ * @param[in] updateCbIn the callback to call
+ * @param[in] userVarIn user variable passed to the callback
+ *
+ * @return true if the callback was dispatched. With an inbox
+ * 		(CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0), false if the target thread's
+ * 		inbox is full. Without one, running out of entries asserts.
+ */
+bool cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Delayed version of ::cxa_runLoop_dispatchNextIteration
+ *
+ * @param[in] delay_msIn the minimum time, in milliseconds, before the callback is called
+ */
+bool cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Determines how long until the next entry registered to the
+ * specified thread is due to be called
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ *
+ * @return 0 if one or more entries should run during the next iteration,
+ * 		::CXA_RUNLOOP_NO_DEADLINE if no entries are scheduled, otherwise the
+ * 		number of microseconds until the earliest timed entry is due
+ */
+uint32_t cxa_runLoop_getTimeUntilNextDeadline_us(int threadIdIn);
+
+/**
+ * @public
+ * @brief Like ::cxa_runLoop_getTimeUntilNextDeadline_us but considers only
+ * started timed entries (untimed entries are ignored)
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ *
+ * @return the number of nanoseconds until the earliest timed entry is due
+ * 		(0 if overdue), UINT64_MAX if there are no timed entries
+ */
+uint64_t cxa_runLoop_getTimeUntilNextTimedEntry_ns(int threadIdIn);
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+/**
+ * @public
+ * @brief Registers a file descriptor with the specified thread. The callback
+ * is only called (from the context of the thread's run loop) when the
+ * descriptor is ready for one of the requested events.
+ *
+ * @param[in] threadIdIn the id of the thread which should service the descriptor
+ * @param[in] fdIn the (preferably non-blocking) file descriptor to monitor
+ * @param[in] eventsIn the ::cxa_runLoop_fdEvent_t flags of interest
+ * @param[in] cbIn the callback to call when the descriptor is ready
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_runLoop_addFdSource(int threadIdIn, int fdIn, int eventsIn, cxa_runLoop_cb_fdReady_t cbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Stops monitoring a file descriptor previously registered
+ * with ::cxa_runLoop_addFdSource. Must be called before closing it.
+ *
+ * @param[in] threadIdIn the id of the thread servicing the descriptor
+ * @param[in] fdIn the file descriptor to remove
+ */
+void cxa_runLoop_removeFdSource(int threadIdIn, int fdIn);
+#endif
 
 uint32_t cxa_runLoop_iterate(int threadIdIn);
 void cxa_runLoop_execute(int threadIdIn);
 
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+/**
+ * @public
+ * @brief Retrieves the statistics for one of the specified thread's entries
+ *
+ * @param[in] threadIdIn the id of the thread in question
+ * @param[in] entryIndexIn index of the entry, 0 to CXA_RUNLOOP_MAXNUM_ENTRIES-1
+ * @param[out] profileOut copy of the entry's statistics
+ *
+ * @return true if there is an active entry at the specified index
+ */
+bool cxa_runLoop_profiler_getProfile(int threadIdIn, size_t entryIndexIn, cxa_runLoop_profile_t *const profileOut);
+
+/**
+ * @public
+ * @brief Clears the statistics for all of the specified thread's entries
+ */
+void cxa_runLoop_profiler_reset(int threadIdIn);
+
+/**
+ * @public
+ * @brief Writes a human-readable summary of all entries of all threads
+ */
+void cxa_runLoop_profiler_writeReport(cxa_ioStream_t *const ioStreamIn);
+#endif
+
+#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+/**
+ * @public
+ * @brief Wakes the specified thread if it is currently sleeping
+ * in ::cxa_runLoop_execute. Safe to call from any thread.
+ *
+ * @param[in] threadIdIn the id of the thread to wake
+ */
+void cxa_runLoop_wakeup(int threadIdIn);
+#endif
+
 
 #endif // CXA_RUN_LOOP_H_
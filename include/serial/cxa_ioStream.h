@@ -13,10 +13,18 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <cxa_bufferChain.h>
 #include <cxa_fixedByteBuffer.h>
 
 
 // ******** global macro definitions ********
+#ifndef CXA_IOSTREAM_FORMATTED_BUFFERLEN_BYTES
+	#define CXA_IOSTREAM_FORMATTED_BUFFERLEN_BYTES				24
+#endif
+
+#ifndef CXA_IOSTREAM_MAXNUM_FRAMED_SEGMENTS
+	#define CXA_IOSTREAM_MAXNUM_FRAMED_SEGMENTS					8
+#endif
 
 
 // ******** global type definitions *********
@@ -51,6 +59,25 @@ typedef enum
 typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const byteOut, void *const userVarIn);
 
 
+/**
+ * @public
+ * @brief Read multiple bytes from the ioStream (optional, see
+ * 		::cxa_ioStream_bind_readBytes). Should return whatever is
+ * 		immediately available rather than waiting for maxNumBytesIn bytes.
+ *
+ * @param[out] buffOut pointer to a location at which to store the received bytes
+ * @param[in] maxNumBytesIn the maximum number of bytes to store at buffOut.
+ * 		Will always be > 0.
+ * @param[out] numBytesReadOut the number of bytes stored at buffOut
+ * 		(only valid if ::CXA_IOSTREAM_READSTAT_GOTDATA is returned)
+ * @param[in] userVarIn pointer to the user-supplied variable passed to
+ * 		::cxa_ioStream_bind
+ *
+ * @return the return status of the read
+ */
+typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readBytes_t)(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+
+
 /**
  * @public
  * @brief Write bytes to the ioStream.
@@ -69,10 +96,32 @@ typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const b
 typedef bool (*cxa_ioStream_cb_writeBytes_t)(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
+/**
+ * @public
+ * @brief Write multiple, non-contiguous runs of bytes to the ioStream in
+ * 		order (optional, see ::cxa_ioStream_bind_writeBytesV). Should
+ * 		be used to submit all segments to the underlying hardware / OS
+ * 		at once (eg. `writev`).
+ *
+ * @param[in] segmentsIn pointer to the segments to write
+ * @param[in] numSegmentsIn the number of segments at segmentsIn.
+ * 		Will always be > 0.
+ * @param[in] userVarIn pointer to the user-supplied variable passed to
+ * 		::cxa_ioStream_bind
+ *
+ * @return true if all bytes were sent / queued to be sent, false if there
+ * 		was an error with the underlying ioStream. If false, number of bytes
+ * 		queued or sent is undetermined.
+ */
+typedef bool (*cxa_ioStream_cb_writeBytesV_t)(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
+
+
 struct cxa_ioStream
 {
 	cxa_ioStream_cb_readByte_t readCb;
+	cxa_ioStream_cb_readBytes_t readBytesCb;
 	cxa_ioStream_cb_writeBytes_t writeCb;
+	cxa_ioStream_cb_writeBytesV_t writeBytesVCb;
 
 	void *userVar;
 };
@@ -82,17 +131,26 @@ struct cxa_ioStream
 void cxa_ioStream_init(cxa_ioStream_t *const ioStreamIn);
 
 void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByte_t readCbIn, cxa_ioStream_cb_writeBytes_t writeCbIn, void *const userVarIn);
+void cxa_ioStream_bind_readBytes(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn);
+void cxa_ioStream_bind_writeBytesV(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_writeBytesV_t writeBytesVCbIn);
 void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn);
 bool cxa_ioStream_isBound(cxa_ioStream_t *const ioStreamIn);
 
 cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn, uint8_t *const byteOut);
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut);
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn);
 
 void cxa_ioStream_clearReadBuffer(cxa_ioStream_t *const ioStreamIn);
 
 bool cxa_ioStream_writeByte(cxa_ioStream_t *const ioStreamIn, uint8_t byteIn);
 bool cxa_ioStream_writeBytes(cxa_ioStream_t *const ioStreamIn, void* buffIn, size_t bufferSize_bytesIn);
+bool cxa_ioStream_writeBytesV(cxa_ioStream_t *const ioStreamIn, cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn);
 bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const fbbIn);
+bool cxa_ioStream_writeBufferChain(cxa_ioStream_t *const ioStreamIn, cxa_bufferChain_t *const chainIn);
+bool cxa_ioStream_writeBufferChain_framed(cxa_ioStream_t *const ioStreamIn,
+										  void *const headerIn, size_t headerSize_bytesIn,
+										  cxa_bufferChain_t *const chainIn,
+										  void *const footerIn, size_t footerSize_bytesIn);
 bool cxa_ioStream_writeString(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
 bool cxa_ioStream_writeLine(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
 bool cxa_ioStream_writeFormattedString(cxa_ioStream_t *const ioStreamIn, const char* formatIn, ...);
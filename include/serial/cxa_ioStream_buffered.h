@@ -0,0 +1,116 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * An ioStream which gathers small writes into a statically allocated buffer
+ * before passing them to an underlying stream. Buffered bytes are written
+ * (in a single call) when:
+ *    - the number of buffered bytes reaches the flush threshold
+ *    - a write would not fit in the remaining buffer space
+ *    - ::cxa_ioStream_buffered_flush is called
+ *    - the run loop of the specified thread finishes an iteration
+ *
+ * Writes which are too large to buffer are passed straight through, together
+ * with any bytes already buffered, as one vectored write. Reads are passed
+ * straight through to the underlying stream.
+ *
+ * @note This object is NOT thread-safe. Write to it only from the thread
+ * 		whose run loop flushes it.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_ioStream_buffered_t myBufferedStream;
+ * uint8_t myBufferedStream_buffer[256];
+ *
+ * cxa_ioStream_buffered_initStd(&myBufferedStream, cxa_usart_getIoStream(myUsart), myBufferedStream_buffer, CXA_RUNLOOP_THREADID_DEFAULT);
+ *
+ * // many small writes...one write to the usart at the end of the iteration
+ * cxa_logger_setGlobalIoStream(&myBufferedStream.super);
+ * @endcode
+ */
+#ifndef CXA_IOSTREAM_BUFFERED_H_
+#define CXA_IOSTREAM_BUFFERED_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cxa_ioStream.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize the stream with a declared c-style array
+ */
+#define cxa_ioStream_buffered_initStd(ioStreamIn, underlyingStreamIn, bufferIn, threadIdIn)		cxa_ioStream_buffered_init((ioStreamIn), (underlyingStreamIn), (void*)(bufferIn), sizeof(bufferIn), (threadIdIn))
+
+
+// ******** global type definitions *********
+typedef struct
+{
+	cxa_ioStream_t super;
+	cxa_ioStream_t* underlyingStream;
+
+	uint8_t* buffer;
+	size_t maxSize_bytes;
+	size_t numBufferedBytes;
+	size_t flushThreshold_bytes;
+}cxa_ioStream_buffered_t;
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the buffered stream. The flush threshold defaults
+ * 		to the size of the buffer.
+ *
+ * @param[in] ioStreamIn pointer to the pre-allocated stream
+ * @param[in] underlyingStreamIn the stream to which buffered bytes are written
+ * @param[in] bufferIn pointer to the pre-allocated buffer
+ * @param[in] bufferSize_bytesIn size of the buffer in bytes
+ * @param[in] threadIdIn id of the thread whose run loop should flush
+ * 		the stream at the end of each iteration
+ */
+void cxa_ioStream_buffered_init(cxa_ioStream_buffered_t *const ioStreamIn,
+								cxa_ioStream_t *const underlyingStreamIn,
+								void *const bufferIn, const size_t bufferSize_bytesIn,
+								int threadIdIn);
+
+/**
+ * @public
+ * @brief Sets the number of buffered bytes which triggers an immediate flush
+ *
+ * @param[in] ioStreamIn pointer to the pre-initialized stream
+ * @param[in] flushThreshold_bytesIn the threshold (1 to the size of the buffer)
+ */
+void cxa_ioStream_buffered_setFlushThreshold(cxa_ioStream_buffered_t *const ioStreamIn, const size_t flushThreshold_bytesIn);
+
+/**
+ * @public
+ * @brief Writes all buffered bytes to the underlying stream. The buffer
+ * 		is emptied even if the write fails.
+ *
+ * @param[in] ioStreamIn pointer to the pre-initialized stream
+ *
+ * @return true if the buffered bytes (if any) were written successfully
+ */
+bool cxa_ioStream_buffered_flush(cxa_ioStream_buffered_t *const ioStreamIn);
+
+/**
+ * @public
+ * @param[in] ioStreamIn pointer to the pre-initialized stream
+ *
+ * @return the number of bytes waiting to be flushed
+ */
+size_t cxa_ioStream_buffered_getNumBufferedBytes(cxa_ioStream_buffered_t *const ioStreamIn);
+
+
+#endif
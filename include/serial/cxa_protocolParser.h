@@ -15,6 +15,7 @@
 
 #include <cxa_config.h>
 #include <cxa_array.h>
+#include <cxa_bufferChain.h>
 #include <cxa_ioStream.h>
 #include <cxa_logger_header.h>
 #include <cxa_timeDiff.h>
@@ -28,6 +29,15 @@
 	#define CXA_PROTOCOLPARSER_MAXNUM_PACKETLISTENERS		1
 #endif
 
+/**
+ * @public
+ * Number of bytes subclasses which scan their input in blocks (eg. crlf,
+ * cleProto) read from the ioStream at once (see ::cxa_protocolParser_rxBlock_peek)
+ */
+#ifndef CXA_PROTOCOLPARSER_RXBLOCK_SIZE_BYTES
+	#define CXA_PROTOCOLPARSER_RXBLOCK_SIZE_BYTES			64
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -95,6 +105,12 @@ typedef void (*cxa_protocolParser_scm_gotoIdle_t)(cxa_protocolParser_t *const su
 typedef bool (*cxa_protocolParser_scm_writeBytes_t)(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn);
 
 
+/**
+ * @private
+ */
+typedef bool (*cxa_protocolParser_scm_writeChain_t)(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn);
+
+
 /**
  * @private
  */
@@ -124,6 +140,22 @@ typedef struct
 }cxa_protocolParser_packetListener_entry_t;
 
 
+/**
+ * @protected
+ * Bytes read from the ioStream (in one block) but not yet consumed by our
+ * subclass. Only allocated by subclasses that read ahead, which register
+ * it using ::cxa_protocolParser_setRxBlock.
+ */
+typedef struct
+{
+	uint8_t buffer[CXA_PROTOCOLPARSER_RXBLOCK_SIZE_BYTES];
+	size_t readIndex;
+	size_t numBytes;
+
+	cxa_ioStream_t passthroughStream;
+}cxa_protocolParser_rxBlock_t;
+
+
 /**
  * @private
  */
@@ -141,12 +173,16 @@ struct cxa_protocolParser
 
 	cxa_ioStream_t* ioStream;
 
+	// NULL unless our subclass reads ahead
+	cxa_protocolParser_rxBlock_t* rxBlock;
+
 	cxa_fixedByteBuffer_t* currBuffer;
 
 	cxa_protocolParser_scm_isInErrorState_t scm_isInError;
 	cxa_protocolParser_scm_canSetBuffer_t scm_canSetBuffer;
 	cxa_protocolParser_scm_gotoIdle_t scm_gotoIdle;
 	cxa_protocolParser_scm_writeBytes_t scm_writeBytes;
+	cxa_protocolParser_scm_writeChain_t scm_writeChain;
 	cxa_protocolParser_scm_reset_t scm_reset;
 };
 
@@ -154,11 +190,14 @@ struct cxa_protocolParser
 // ******** global function prototypes ********
 /**
  * @protected
+ * Subclasses must supply at least one of scm_writeBytesIn and scm_writeChainIn (the
+ * other may be NULL). Subclasses that frame packets by simply surrounding the data
+ * should supply scm_writeChainIn so that chains can be written without a copy.
  */
 void cxa_protocolParser_init(cxa_protocolParser_t *const ppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
 							 cxa_protocolParser_scm_isInErrorState_t scm_isInErrorIn, cxa_protocolParser_scm_canSetBuffer_t scm_canSetBufferIn,
 							 cxa_protocolParser_scm_gotoIdle_t scm_gotoIdleIn, cxa_protocolParser_scm_reset_t scm_resetIn,
-							 cxa_protocolParser_scm_writeBytes_t scm_writeBytesIn);
+							 cxa_protocolParser_scm_writeBytes_t scm_writeBytesIn, cxa_protocolParser_scm_writeChain_t scm_writeChainIn);
 
 /**
  * @public
@@ -257,6 +296,24 @@ bool cxa_protocolParser_writePacket(cxa_protocolParser_t *const ppIn, cxa_fixedB
  */
 bool cxa_protocolParser_writePacket_bytes(cxa_protocolParser_t *const ppIn, void* bytesIn, size_t numBytesIn);
 
+/**
+ * @public
+ * @brief Writes a packet, whose data is scattered across memory, to the ioStream
+ * 		without first copying the data into a contiguous buffer.
+ *
+ * @note Protocols that only know how to write a ::cxa_fixedByteBuffer_t accept
+ * 		single-segment chains only. Protocols that identify the packet by its
+ * 		buffer (eg. MQTT) do not accept chains at all.
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ * @param[in] chainIn the data to send. Should not include
+ * 		header, footer, etc (will be automatically added)
+ *
+ * @return true if the packet was sent successfully, false if there
+ * 		was an error with the underlying ioStream (or the chain is not supported)
+ */
+bool cxa_protocolParser_writePacket_chain(cxa_protocolParser_t *const ppIn, cxa_bufferChain_t *const chainIn);
+
 /**
  * @public
  * @brief Resets the protocol parser if an ioException has occurred.
@@ -268,6 +325,74 @@ bool cxa_protocolParser_writePacket_bytes(cxa_protocolParser_t *const ppIn, void
  */
 void cxa_protocolParser_resetError(cxa_protocolParser_t *const ppIn);
 
+/**
+ * @public
+ * @brief Returns an ioStream which first returns any bytes the parser has
+ * 		read from the underlying ioStream (but not yet parsed), followed by
+ * 		the underlying ioStream itself. Writes go straight to the underlying
+ * 		ioStream. For parsers which don't read ahead, this is simply the
+ * 		underlying ioStream.
+ *
+ * Parsers may read ahead of the end of the current packet. Anyone reading the
+ * underlying ioStream directly (eg. while the parser is paused) must read from
+ * this ioStream instead so that those bytes are not lost.
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ *
+ * @return the passthrough ioStream
+ */
+cxa_ioStream_t* cxa_protocolParser_getPassthroughIoStream(cxa_protocolParser_t *const ppIn);
+
+
+/**
+ * @public
+ * @brief Throws away any bytes the parser has read from the underlying
+ * 		ioStream but not yet parsed. Called automatically by
+ * 		::cxa_protocolParser_reset, ::cxa_protocolParser_resetError and
+ * 		on ioStream exceptions. Call it manually whenever the underlying
+ * 		ioStream starts over (eg. a new connection).
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ */
+void cxa_protocolParser_rxBlock_discard(cxa_protocolParser_t *const ppIn);
+
+
+/**
+ * @protected
+ * @brief Registers the (subclass-allocated) read-ahead block used by
+ * 		::cxa_protocolParser_rxBlock_peek and ::cxa_protocolParser_rxBlock_consume.
+ * 		Must be called immediately after ::cxa_protocolParser_init.
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ * @param[in] rxBlockIn pointer to the pre-allocated read-ahead block
+ */
+void cxa_protocolParser_setRxBlock(cxa_protocolParser_t *const ppIn, cxa_protocolParser_rxBlock_t *const rxBlockIn);
+
+
+/**
+ * @protected
+ * @brief Provides access to the bytes received, but not yet consumed, by the
+ * 		parser. If there are none, a single block is read from the underlying
+ * 		ioStream. Follow with ::cxa_protocolParser_rxBlock_consume.
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ * @param[out] bytesOut set to the first unconsumed byte (only valid on GOTDATA)
+ * @param[out] numBytesOut the number of contiguous unconsumed bytes (only valid on GOTDATA)
+ *
+ * @return the status of the underlying ioStream (GOTDATA if there are unconsumed bytes)
+ */
+cxa_ioStream_readStatus_t cxa_protocolParser_rxBlock_peek(cxa_protocolParser_t *const ppIn, uint8_t **const bytesOut, size_t *const numBytesOut);
+
+
+/**
+ * @protected
+ * @brief Marks bytes returned by ::cxa_protocolParser_rxBlock_peek as consumed
+ *
+ * @param[in] ppIn pointer to the pre-initialized protocolParser
+ * @param[in] numBytesIn the number of bytes consumed (must not exceed the number peeked)
+ */
+void cxa_protocolParser_rxBlock_consume(cxa_protocolParser_t *const ppIn, size_t numBytesIn);
+
 
 /**
  * @protected
@@ -23,6 +23,7 @@ typedef struct cxa_protocolParser_cleProto cxa_protocolParser_cleProto_t;
 struct cxa_protocolParser_cleProto
 {
 	cxa_protocolParser_t super;
+	cxa_protocolParser_rxBlock_t rxBlock;
 
 	cxa_stateMachine_t stateMachine;
 };
@@ -23,6 +23,7 @@ typedef struct cxa_protocolParser_crlf cxa_protocolParser_crlf_t;
 struct cxa_protocolParser_crlf
 {
 	cxa_protocolParser_t super;
+	cxa_protocolParser_rxBlock_t rxBlock;
 
 	bool isPaused;
 	cxa_stateMachine_t stateMachine;
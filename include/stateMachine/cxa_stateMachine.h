@@ -19,6 +19,9 @@
 #ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
 	#include <cxa_timeDiff.h>
 #endif
+#ifdef CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP
+	#include <cxa_hashMap.h>
+#endif
 
 
 // ******** global macro definitions ********
@@ -26,6 +29,17 @@
 	#define CXA_STATE_MACHINE_MAXNUM_STATES				16
 #endif
 
+/**
+ * Define CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP (in cxa_config.h) to find
+ * states by id using a hash map rather than a linear search on every
+ * transition. This costs CXA_STATE_MACHINE_HASHMAP_SIZE map entries of
+ * RAM per state machine (which should be comfortably larger than
+ * CXA_STATE_MACHINE_MAXNUM_STATES).
+ */
+#ifndef CXA_STATE_MACHINE_HASHMAP_SIZE
+	#define CXA_STATE_MACHINE_HASHMAP_SIZE				((CXA_STATE_MACHINE_MAXNUM_STATES * 4) / 3 + 1)
+#endif
+
 #define CXA_STATE_MACHINE_STATE_UNKNOWN						-1
 
 
@@ -91,13 +105,19 @@ struct cxa_stateMachine
 	cxa_array_t states;
 	cxa_stateMachine_state_t states_raw[CXA_STATE_MACHINE_MAXNUM_STATES];
 
+	#ifdef CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP
+		cxa_hashMap_t statesById;
+		cxa_hashMap_entry_t statesById_entries[CXA_STATE_MACHINE_HASHMAP_SIZE];
+	#endif
+
 	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 		cxa_logger_t logger;
 	#endif
 
 	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
 		bool timedStatesEnabled;
-		cxa_timeDiff_t td_timedTransition;
+		int threadId;
+		cxa_timeDiff64_t td_timedTransition;
 	#endif
 };
 
@@ -55,6 +55,17 @@ typedef struct
 }cxa_timeDiff_t;
 
 
+/**
+ * @public
+ * A timeDiff backed by ::cxa_timeBase_getCount_ns. It never rolls over,
+ * so it is suitable for long timeouts on long-running systems.
+ */
+typedef struct
+{
+	uint64_t startTime_ns;
+}cxa_timeDiff64_t;
+
+
 // ******** global function prototypes ********
 /**
  * @public
@@ -117,4 +128,67 @@ bool cxa_timeDiff_isElapsed_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn);
 bool cxa_timeDiff_isElapsed_recurring_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn);
 
 
+/**
+ * @public
+ * @brief Initializes the timeDiff64 (startTime is set to now)
+ *
+ * @param[in] tdIn the pre-allocated timeDiff64 object
+ */
+void cxa_timeDiff64_init(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ * @brief Sets the "startTime" of the timeDiff64 to the current value of the
+ * reference timeBase
+ *
+ * @param[in] tdIn the pre-initialized timeDiff64
+ */
+void cxa_timeDiff64_setStartTime_now(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ * @brief Sets the "startTime" of the timeDiff64 to a previously sampled
+ * time (eg. ::cxa_runLoop_getIterationTime_ns) to avoid sampling the
+ * timeBase again
+ *
+ * @param[in] tdIn the pre-initialized timeDiff64
+ * @param[in] startTime_nsIn the start time, in nanoseconds
+ */
+void cxa_timeDiff64_setStartTime_ns(cxa_timeDiff64_t *const tdIn, uint64_t startTime_nsIn);
+
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff64
+ * @param[in] now_nsIn the current time, in nanoseconds (eg. from
+ * 		::cxa_timeBase_getCount_ns or ::cxa_runLoop_getIterationTime_ns)
+ *
+ * @return the amount of time (in nanoseconds) between the startTime and now_nsIn
+ */
+uint64_t cxa_timeDiff64_getElapsedTime_ns(cxa_timeDiff64_t *const tdIn, uint64_t now_nsIn);
+
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff64
+ *
+ * @return the amount of time (in milliseconds) since the startTime
+ */
+uint64_t cxa_timeDiff64_getElapsedTime_ms(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ * @brief 64-bit equivalent of ::cxa_timeDiff_isElapsed_ms (never rolls over)
+ */
+bool cxa_timeDiff64_isElapsed_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn);
+
+/**
+ * @public
+ * @brief 64-bit equivalent of ::cxa_timeDiff_isElapsed_recurring_ms.
+ * The next period starts where this one ended (rather than now) so
+ * periods don't drift.
+ */
+bool cxa_timeDiff64_isElapsed_recurring_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn);
+
+
 #endif // CXA_TIMEBASE_H_
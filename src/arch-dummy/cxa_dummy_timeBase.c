@@ -0,0 +1,91 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_dummy_timeBase.h"
+
+
+// ******** includes ********
+#include <cxa_assert.h>
+#include <cxa_runLoop.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+static uint64_t currTime_ns = 0;
+
+
+// ******** global function implementations ********
+void cxa_dummy_timeBase_init(uint64_t startTime_nsIn)
+{
+	currTime_ns = startTime_nsIn;
+}
+
+
+void cxa_dummy_timeBase_advance_ns(uint64_t delta_nsIn)
+{
+	currTime_ns += delta_nsIn;
+}
+
+
+uint32_t cxa_dummy_timeBase_runLoop_simulate(int threadIdIn, uint32_t duration_msIn, uint32_t maxStep_usIn)
+{
+	cxa_assert(maxStep_usIn > 0);
+
+	uint64_t endTime_ns = currTime_ns + ((uint64_t)duration_msIn * 1000000);
+	uint32_t numIterations = 0;
+
+	while( true )
+	{
+		cxa_runLoop_iterate(threadIdIn);
+		numIterations++;
+		if( currTime_ns >= endTime_ns ) break;
+
+		// jump to the next deadline (but not past the end of the simulation)
+		uint64_t step_ns = endTime_ns - currTime_ns;
+		uint64_t untilNextTimed_ns = cxa_runLoop_getTimeUntilNextTimedEntry_ns(threadIdIn);
+		if( untilNextTimed_ns < step_ns ) step_ns = untilNextTimed_ns;
+
+		// untimed entries may be waiting on time we can't see...don't skip too far
+		if( cxa_runLoop_getTimeUntilNextDeadline_us(threadIdIn) == 0 )
+		{
+			uint64_t maxStep_ns = (uint64_t)maxStep_usIn * 1000;
+			if( (step_ns == 0) || (step_ns > maxStep_ns) ) step_ns = maxStep_ns;
+		}
+
+		currTime_ns += step_ns;
+	}
+
+	return numIterations;
+}
+
+
+uint32_t cxa_timeBase_getCount_us(void)
+{
+	return (uint32_t)(currTime_ns / 1000);
+}
+
+
+uint32_t cxa_timeBase_getMaxCount_us(void)
+{
+	return UINT32_MAX;
+}
+
+
+uint64_t cxa_timeBase_getCount_ns(void)
+{
+	return currTime_ns;
+}
+
+
+// ******** local function implementations ********
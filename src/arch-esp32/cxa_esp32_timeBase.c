@@ -43,4 +43,10 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount_ns(void)
+{
+	return (uint64_t)esp_timer_get_time() * 1000;
+}
+
+
 // ******** local function implementations ********
@@ -28,6 +28,7 @@
 static bool set_blocking(cxa_ioStream_file_t *const ioStreamIn, bool should_block);
 
 static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
@@ -39,6 +40,8 @@ void cxa_ioStream_file_init(cxa_ioStream_file_t *const ioStreamIn)
 {
 	cxa_assert(ioStreamIn);
 
+	ioStreamIn->file = NULL;
+
 	// initialize our super class
 	cxa_ioStream_init(&ioStreamIn->super);
 }
@@ -63,6 +66,7 @@ void cxa_ioStream_file_setFile(cxa_ioStream_file_t *const ioStreamIn, FILE *cons
 
 	// get ready for use
 	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
 }
 
 
@@ -76,10 +80,19 @@ void cxa_ioStream_file_close(cxa_ioStream_file_t *const ioStreamIn)
 	{
 		set_blocking(ioStreamIn, false);
 		fclose(ioStreamIn->file);
+		ioStreamIn->file = NULL;
 	}
 }
 
 
+int cxa_ioStream_file_getFileDescriptor(cxa_ioStream_file_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	return (ioStreamIn->file != NULL) ? fileno(ioStreamIn->file) : -1;
+}
+
+
 // ******** local function implementations ********
 static bool set_blocking(cxa_ioStream_file_t *const ioStreamIn, bool should_block)
 {
@@ -118,6 +131,24 @@ static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const use
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_file_t* ioStreamIn = (cxa_ioStream_file_t*)userVarIn;
+
+	int fd = fileno(ioStreamIn->file);
+	cxa_assert(fd >= 0);
+
+	// one syscall for everything that's available
+	ssize_t retVal_read = read(fd, buffOut, maxNumBytesIn);
+	if( retVal_read < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
+	else if( retVal_read == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	*numBytesReadOut = (size_t)retVal_read;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
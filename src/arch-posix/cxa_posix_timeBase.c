@@ -10,11 +10,9 @@
 // ******** includes ********
 #include <cxa_assert.h>
 #include <time.h>
-#include <sys/time.h>
 
 #ifdef __MACH__
-#include <mach/clock.h>
-#include <mach/mach.h>
+#include <mach/mach_time.h>
 #endif
 
 
@@ -25,7 +23,7 @@
 
 
 // ******** local function prototypes ********
-static void current_utc_time(struct timeval *ts);
+static uint64_t current_monotonic_time_ns(void);
 
 
 // ********  local variable declarations *********
@@ -36,9 +34,7 @@ static void current_utc_time(struct timeval *ts);
 
 uint32_t cxa_timeBase_getCount_us(void)
 {
-	struct timeval ts;
-	current_utc_time(&ts);
-	return (1000000 * ts.tv_sec) + (ts.tv_usec);
+	return (uint32_t)(current_monotonic_time_ns() / 1000);
 }
 
 
@@ -48,18 +44,23 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount_ns(void)
+{
+	return current_monotonic_time_ns();
+}
+
+
 // ******** local function implementations ********
-static void current_utc_time(struct timeval *ts)
+static uint64_t current_monotonic_time_ns(void)
 {
-	#ifdef __MACH__ // OS X does not have clock_gettime, use clock_get_time
-		clock_serv_t cclock;
-		mach_timespec_t mts;
-		host_get_clock_service(mach_host_self(), CALENDAR_CLOCK, &cclock);
-		clock_get_time(cclock, &mts);
-		mach_port_deallocate(mach_task_self(), cclock);
-		ts->tv_sec = mts.tv_sec;
-		ts->tv_usec = mts.tv_nsec / 1000;
+	// (not the wall clock...that can jump with NTP / user changes)
+	#ifdef __MACH__
+		static mach_timebase_info_data_t timebaseInfo;
+		if( timebaseInfo.denom == 0 ) mach_timebase_info(&timebaseInfo);
+		return (mach_absolute_time() * timebaseInfo.numer) / timebaseInfo.denom;
 	#else
-		gettimeofday(ts, NULL);
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
 	#endif
 }
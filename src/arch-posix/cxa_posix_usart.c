@@ -9,26 +9,59 @@
 
 // ******** includes ********
 #include <stdbool.h>
+#include <stddef.h>
 #include <cxa_assert.h>
+#include <cxa_numberUtils.h>
+#include <cxa_runLoop.h>
 
 #include <errno.h>
+#include <limits.h>
+#include <poll.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/uio.h>
 
 
 // ******** local macro definitions ********
+#define READERTHREAD_POLL_PERIOD_MS				100
+#define READERTHREAD_FIFOFULL_BACKOFF_US		1000
+
+// glibc only declares IOV_MAX with _XOPEN_SOURCE / _GNU_SOURCE...fall back to the POSIX minimum
+#ifndef IOV_MAX
+	#define IOV_MAX								16
+#endif
 
 
 // ******** local type definitions ********
+// segments are handed to writev as-is
+_Static_assert(sizeof(cxa_bufferChain_segment_t) == sizeof(struct iovec), "segment / iovec mismatch");
+_Static_assert(offsetof(cxa_bufferChain_segment_t, data) == offsetof(struct iovec, iov_base), "segment / iovec mismatch");
+_Static_assert(offsetof(cxa_bufferChain_segment_t, size_bytes) == offsetof(struct iovec, iov_len), "segment / iovec mismatch");
 
 
 // ******** local function prototypes ********
 static bool set_interface_attribs (int fd, int speed, int parity);
 static bool set_blocking (int fd, int should_block);
+static bool openNonBlocking(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn);
+static void bindIoStream(cxa_posix_usart_t *const usartIn);
+
+static inline bool isRetryableError(int errnoIn);
+static bool waitUntilWritable(int fdIn);
+static bool fillRxFifo(cxa_posix_usart_t *const usartIn);
+static cxa_ioStream_readStatus_t readFromRxFifo(cxa_posix_usart_t *const usartIn, uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut);
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+static void cb_onFdReady(int fdIn, int eventsIn, void* userVarIn);
+#endif
+#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+static void* readerThread(void* userVarIn);
+#endif
 
 static cxa_ioStream_readStatus_t ioStream_cb_readByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t ioStream_cb_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool ioStream_cb_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -40,6 +73,9 @@ bool cxa_posix_usart_init_noHH(cxa_posix_usart_t *const usartIn, char *const pat
 	cxa_assert(usartIn);
 	cxa_assert(pathIn);
 
+	usartIn->rxMode = CXA_POSIX_USART_RXMODE_DIRECT;
+	usartIn->isRxFifoFilledByRunLoop = false;
+
 	usartIn->fd = open(pathIn, O_RDWR | O_NOCTTY | O_SYNC);
 	if( usartIn->fd < 0 ) return false;
 
@@ -47,30 +83,91 @@ bool cxa_posix_usart_init_noHH(cxa_posix_usart_t *const usartIn, char *const pat
 	if( !set_blocking (usartIn->fd, 0) ) return false;
 
 	// setup our ioStream (last once everything is setup)
-	cxa_ioStream_init(&usartIn->super.ioStream);
-	cxa_ioStream_bind(&usartIn->super.ioStream, ioStream_cb_readByte, ioStream_cb_writeBytes, (void*)usartIn);
+	bindIoStream(usartIn);
 
 	return true;
 }
 
 
+bool cxa_posix_usart_init_noHH_nonBlocking(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn)
+{
+	cxa_assert(usartIn);
+	cxa_assert(pathIn);
+
+	if( !openNonBlocking(usartIn, pathIn, baudRateIn, threadIdIn) ) return false;
+	usartIn->rxMode = CXA_POSIX_USART_RXMODE_NONBLOCKING;
+	cxa_fixedFifo_initStd(&usartIn->rxFifo, CXA_FF_ON_FULL_DROP, usartIn->rxFifo_buffer);
+
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	// only touch the port when it has something for us
+	cxa_runLoop_addFdSource(threadIdIn, usartIn->fd, CXA_RUNLOOP_FDEVENT_READABLE, cb_onFdReady, (void*)usartIn);
+	usartIn->isRxFifoFilledByRunLoop = true;
+	#endif
+
+	// setup our ioStream (last once everything is setup)
+	bindIoStream(usartIn);
+
+	return true;
+}
+
+
+#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+bool cxa_posix_usart_init_noHH_readerThread(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn)
+{
+	cxa_assert(usartIn);
+	cxa_assert(pathIn);
+
+	if( !openNonBlocking(usartIn, pathIn, baudRateIn, threadIdIn) ) return false;
+	usartIn->rxMode = CXA_POSIX_USART_RXMODE_READERTHREAD;
+
+	// filled by the reader thread, emptied by the run loop
+	cxa_fixedFifo_initSpscStd(&usartIn->rxFifo, usartIn->rxFifo_buffer);
+
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	// make sure the run loop's context exists before the reader thread tries to wake it
+	cxa_runLoop_wakeup(threadIdIn);
+	#endif
+
+	if( pthread_create(&usartIn->readerThread, NULL, readerThread, (void*)usartIn) != 0 )
+	{
+		close(usartIn->fd);
+		return false;
+	}
+
+	// setup our ioStream (last once everything is setup)
+	bindIoStream(usartIn);
+
+	return true;
+}
+#endif
+
+
 void cxa_posix_usart_close(cxa_posix_usart_t *const usartIn)
 {
 	cxa_assert(usartIn);
 
+	#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+	if( usartIn->rxMode == CXA_POSIX_USART_RXMODE_READERTHREAD )
+	{
+		atomic_store(&usartIn->readerThread_shouldStop, true);
+		pthread_join(usartIn->readerThread, NULL);
+	}
+	#endif
+
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	if( usartIn->isRxFifoFilledByRunLoop ) cxa_runLoop_removeFdSource(usartIn->threadId, usartIn->fd);
+	#endif
+
 	close(usartIn->fd);
 }
 
 
-/*
-FILE* cxa_usart_getFileDescriptor(cxa_usart_t *const superIn)
+int cxa_posix_usart_getFileDescriptor(cxa_posix_usart_t *const usartIn)
 {
-	cxa_assert(superIn);
-	cxa_x86posix_usart_t *const usartIn = (cxa_x86posix_usart_t *const)superIn;
+	cxa_assert(usartIn);
 
 	return usartIn->fd;
 }
-*/
 
 
 // ******** local function implementations ********
@@ -123,11 +220,172 @@ static bool set_blocking (int fd, int should_block)
 }
 
 
+static bool openNonBlocking(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, int threadIdIn)
+{
+	usartIn->threadId = threadIdIn;
+	usartIn->isRxFifoFilledByRunLoop = false;
+	usartIn->hasRxError = false;
+	#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+	atomic_init(&usartIn->readerThread_shouldStop, false);
+	atomic_init(&usartIn->readerThread_hasError, false);
+	#endif
+
+	// no O_SYNC...writes complete once the kernel has buffered them
+	usartIn->fd = open(pathIn, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if( usartIn->fd < 0 ) return false;
+
+	struct termios tty;
+	if( !set_interface_attribs (usartIn->fd, baudRateIn, 0) || (tcgetattr(usartIn->fd, &tty) != 0) )
+	{
+		close(usartIn->fd);
+		return false;
+	}
+
+	// return whatever is available immediately
+	tty.c_cc[VMIN] = 0;
+	tty.c_cc[VTIME] = 0;
+	if( tcsetattr(usartIn->fd, TCSANOW, &tty) != 0 )
+	{
+		close(usartIn->fd);
+		return false;
+	}
+
+	return true;
+}
+
+
+static void bindIoStream(cxa_posix_usart_t *const usartIn)
+{
+	cxa_ioStream_init(&usartIn->super.ioStream);
+	cxa_ioStream_bind(&usartIn->super.ioStream, ioStream_cb_readByte, ioStream_cb_writeBytes, (void*)usartIn);
+	cxa_ioStream_bind_readBytes(&usartIn->super.ioStream, ioStream_cb_readBytes);
+	cxa_ioStream_bind_writeBytesV(&usartIn->super.ioStream, ioStream_cb_writeBytesV);
+}
+
+
+static inline bool isRetryableError(int errnoIn)
+{
+	return (errnoIn == EAGAIN) || (errnoIn == EWOULDBLOCK) || (errnoIn == EINTR);
+}
+
+
+static bool waitUntilWritable(int fdIn)
+{
+	// only happens for non-blocking ports when the kernel's transmit buffer is full
+	struct pollfd pfd = {.fd=fdIn, .events=POLLOUT, .revents=0};
+	return (poll(&pfd, 1, CXA_POSIX_USART_WRITE_TIMEOUT_MS) > 0) && !(pfd.revents & (POLLERR | POLLHUP | POLLNVAL));
+}
+
+
+static bool fillRxFifo(cxa_posix_usart_t *const usartIn)
+{
+	while( true )
+	{
+		// read straight into the fifo (up to twice if the free space wraps)
+		void* freeSpace;
+		size_t numFreeBytes = cxa_fixedFifo_bulkQueue_reserve(&usartIn->rxFifo, &freeSpace);
+		if( numFreeBytes == 0 ) return true;
+
+		ssize_t retVal_read = read(usartIn->fd, freeSpace, numFreeBytes);
+		if( retVal_read < 0 ) return isRetryableError(errno);
+		if( retVal_read == 0 ) return true;
+
+		cxa_fixedFifo_bulkQueue_commit(&usartIn->rxFifo, (size_t)retVal_read);
+
+		// we've emptied the kernel's buffer
+		if( (size_t)retVal_read < numFreeBytes ) return true;
+	}
+}
+
+
+static cxa_ioStream_readStatus_t readFromRxFifo(cxa_posix_usart_t *const usartIn, uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut)
+{
+	// refill on demand if nobody else is doing it for us
+	if( (usartIn->rxMode == CXA_POSIX_USART_RXMODE_NONBLOCKING) && !usartIn->isRxFifoFilledByRunLoop &&
+		cxa_fixedFifo_isEmpty(&usartIn->rxFifo) && !fillRxFifo(usartIn) )
+	{
+		usartIn->hasRxError = true;
+	}
+
+	*numBytesReadOut = cxa_fixedFifo_bulkDequeue_copy(&usartIn->rxFifo, buffOut, maxNumBytesIn);
+	if( *numBytesReadOut > 0 ) return CXA_IOSTREAM_READSTAT_GOTDATA;
+
+	// errors are only reported once everything received before them has been read
+	#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+	if( (usartIn->rxMode == CXA_POSIX_USART_RXMODE_READERTHREAD) && atomic_load(&usartIn->readerThread_hasError) ) return CXA_IOSTREAM_READSTAT_ERROR;
+	#endif
+	return usartIn->hasRxError ? CXA_IOSTREAM_READSTAT_ERROR : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+static void cb_onFdReady(int fdIn, int eventsIn, void* userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+	if( !fillRxFifo(usartIn) || (eventsIn & CXA_RUNLOOP_FDEVENT_ERROR) )
+	{
+		// the port won't recover...stop polling it
+		usartIn->hasRxError = true;
+		cxa_runLoop_removeFdSource(usartIn->threadId, fdIn);
+		usartIn->isRxFifoFilledByRunLoop = false;
+	}
+}
+#endif
+
+
+#ifdef CXA_POSIX_USART_READERTHREAD_ENABLE
+static void* readerThread(void* userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+	while( !atomic_load(&usartIn->readerThread_shouldStop) )
+	{
+		// give the consumer a chance to catch up (the kernel keeps buffering)
+		if( cxa_fixedFifo_isFull(&usartIn->rxFifo) )
+		{
+			usleep(READERTHREAD_FIFOFULL_BACKOFF_US);
+			continue;
+		}
+
+		// timeout so we notice when we should stop
+		struct pollfd pfd = {.fd=usartIn->fd, .events=POLLIN, .revents=0};
+		int retVal_poll = poll(&pfd, 1, READERTHREAD_POLL_PERIOD_MS);
+		if( (retVal_poll < 0) && (errno == EINTR) ) continue;
+		if( retVal_poll == 0 ) continue;
+
+		if( (retVal_poll < 0) || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) || !fillRxFifo(usartIn) )
+		{
+			atomic_store(&usartIn->readerThread_hasError, true);
+			break;
+		}
+
+		#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+		cxa_runLoop_wakeup(usartIn->threadId);
+		#endif
+	}
+
+	return NULL;
+}
+#endif
+
+
 static cxa_ioStream_readStatus_t ioStream_cb_readByte(uint8_t *const byteOut, void *const userVarIn)
 {
 	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
 	cxa_assert(usartIn);
 
+	if( usartIn->rxMode != CXA_POSIX_USART_RXMODE_DIRECT )
+	{
+		uint8_t rxByte;
+		size_t numBytesRead;
+		cxa_ioStream_readStatus_t retVal = readFromRxFifo(usartIn, &rxByte, 1, &numBytesRead);
+		if( (retVal == CXA_IOSTREAM_READSTAT_GOTDATA) && (byteOut != NULL) ) *byteOut = rxByte;
+		return retVal;
+	}
+
 	// perform our read and check the return value
 	ssize_t retVal_read = read(usartIn->fd, byteOut, 1);
 	if( retVal_read < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
@@ -137,6 +395,23 @@ static cxa_ioStream_readStatus_t ioStream_cb_readByte(uint8_t *const byteOut, vo
 }
 
 
+static cxa_ioStream_readStatus_t ioStream_cb_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+	if( usartIn->rxMode != CXA_POSIX_USART_RXMODE_DIRECT ) return readFromRxFifo(usartIn, buffOut, maxNumBytesIn, numBytesReadOut);
+
+	// one syscall for everything the driver has buffered
+	ssize_t retVal_read = read(usartIn->fd, buffOut, maxNumBytesIn);
+	if( retVal_read < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
+	else if( retVal_read == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	*numBytesReadOut = (size_t)retVal_read;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
 static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
@@ -147,7 +422,11 @@ static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 	while( numBytesRemaining != 0 )
 	{
 		ssize_t retVal_write = write(usartIn->fd, (void*)&(((uint8_t*)buffIn)[numBytesSent]), numBytesRemaining);
-		if( retVal_write < 0 ) return false;
+		if( retVal_write < 0 )
+		{
+			if( isRetryableError(errno) && waitUntilWritable(usartIn->fd) ) continue;
+			return false;
+		}
 
 		// if we made it here, retVal_write is positive
 		numBytesSent += (size_t)retVal_write;
@@ -156,3 +435,44 @@ static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 
 	return true;
 }
+
+
+static bool ioStream_cb_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+	size_t currSegmentIndex = 0;
+	size_t currSegmentOffset = 0;
+	while( currSegmentIndex < numSegmentsIn )
+	{
+		// finish a partially-written segment on its own (so we don't modify the caller's segments)
+		if( currSegmentOffset > 0 )
+		{
+			cxa_bufferChain_segment_t* currSegment = &segmentsIn[currSegmentIndex];
+			if( !ioStream_cb_writeBytes(&(((uint8_t*)currSegment->data)[currSegmentOffset]), (currSegment->size_bytes - currSegmentOffset), userVarIn) ) return false;
+
+			currSegmentIndex++;
+			currSegmentOffset = 0;
+			continue;
+		}
+
+		ssize_t retVal_write = writev(usartIn->fd, (struct iovec*)&segmentsIn[currSegmentIndex], (int)CXA_MIN((numSegmentsIn - currSegmentIndex), (size_t)IOV_MAX));
+		if( retVal_write < 0 )
+		{
+			if( isRetryableError(errno) && waitUntilWritable(usartIn->fd) ) continue;
+			return false;
+		}
+
+		// skip past everything that was fully written
+		size_t numBytesWritten = (size_t)retVal_write;
+		while( (currSegmentIndex < numSegmentsIn) && (numBytesWritten >= segmentsIn[currSegmentIndex].size_bytes) )
+		{
+			numBytesWritten -= segmentsIn[currSegmentIndex].size_bytes;
+			currSegmentIndex++;
+		}
+		currSegmentOffset = numBytesWritten;
+	}
+
+	return true;
+}
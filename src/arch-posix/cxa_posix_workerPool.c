@@ -0,0 +1,257 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_posix_workerPool.h"
+
+
+// ******** includes ********
+#include <stdint.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define WORKER_INDEX_NONE					SIZE_MAX
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void* workerThread(void* argIn);
+static bool takeTask(cxa_posix_workerPool_t *const poolIn, size_t ownWorkerIndexIn, cxa_posix_workerPool_task_t *const taskOut);
+static void runTask(cxa_posix_workerPool_t *const poolIn, cxa_posix_workerPool_task_t *const taskIn);
+
+static bool deque_pushBack(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskIn);
+static bool deque_popBack(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskOut);
+static bool deque_popFront(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskOut);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_posix_workerPool_init(cxa_posix_workerPool_t *const poolIn, size_t numWorkersIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert( (numWorkersIn > 0) && (numWorkersIn <= CXA_POSIX_WORKERPOOL_MAXNUM_WORKERS) );
+
+	// save our references
+	poolIn->numWorkers = numWorkersIn;
+	poolIn->nextWorkerIndex = 0;
+	atomic_init(&poolIn->numQueuedTasks, 0);
+	atomic_init(&poolIn->numPendingTasks, 0);
+	atomic_init(&poolIn->numSleepingWorkers, 0);
+	poolIn->shouldExit = false;
+
+	cxa_assert(pthread_mutex_init(&poolIn->mutex, NULL) == 0);
+	cxa_assert(pthread_cond_init(&poolIn->cond_workAvailable, NULL) == 0);
+	cxa_assert(pthread_cond_init(&poolIn->cond_idle, NULL) == 0);
+
+	// setup (and start) our workers
+	for( size_t i = 0; i < poolIn->numWorkers; i++ )
+	{
+		cxa_posix_workerPool_worker_t* currWorker = &poolIn->workers[i];
+
+		currWorker->pool = poolIn;
+		currWorker->dequeHead = 0;
+		currWorker->dequeSize = 0;
+		cxa_assert(pthread_mutex_init(&currWorker->dequeMutex, NULL) == 0);
+	}
+	for( size_t i = 0; i < poolIn->numWorkers; i++ )
+	{
+		cxa_assert(pthread_create(&poolIn->workers[i].thread, NULL, workerThread, &poolIn->workers[i]) == 0);
+	}
+}
+
+
+void cxa_posix_workerPool_deinit(cxa_posix_workerPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	pthread_mutex_lock(&poolIn->mutex);
+	poolIn->shouldExit = true;
+	pthread_cond_broadcast(&poolIn->cond_workAvailable);
+	pthread_mutex_unlock(&poolIn->mutex);
+
+	for( size_t i = 0; i < poolIn->numWorkers; i++ )
+	{
+		pthread_join(poolIn->workers[i].thread, NULL);
+		pthread_mutex_destroy(&poolIn->workers[i].dequeMutex);
+	}
+
+	pthread_cond_destroy(&poolIn->cond_idle);
+	pthread_cond_destroy(&poolIn->cond_workAvailable);
+	pthread_mutex_destroy(&poolIn->mutex);
+	poolIn->numWorkers = 0;
+}
+
+
+void cxa_posix_workerPool_submit(cxa_posix_workerPool_t *const poolIn, cxa_posix_workerPool_cb_t cbIn, void *const userVarIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(cbIn);
+
+	cxa_posix_workerPool_task_t newTask = {.cb = cbIn, .userVar = userVarIn};
+
+	// count the task before it's visible...an awake worker may take (and finish) it right away
+	atomic_fetch_add(&poolIn->numPendingTasks, 1);
+	atomic_fetch_add(&poolIn->numQueuedTasks, 1);
+
+	// spread tasks across our workers (skipping any that are full)
+	bool wasQueued = false;
+	for( size_t i = 0; !wasQueued && (i < poolIn->numWorkers); i++ )
+	{
+		cxa_posix_workerPool_worker_t* targetWorker = &poolIn->workers[poolIn->nextWorkerIndex];
+		poolIn->nextWorkerIndex = (poolIn->nextWorkerIndex + 1) % poolIn->numWorkers;
+
+		wasQueued = deque_pushBack(targetWorker, &newTask);
+	}
+	cxa_assert_msg(wasQueued, "increase CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER");
+
+	// only take the lock if someone needs waking (pairs with the sleep check in workerThread)
+	if( atomic_load(&poolIn->numSleepingWorkers) > 0 )
+	{
+		pthread_mutex_lock(&poolIn->mutex);
+		pthread_cond_signal(&poolIn->cond_workAvailable);
+		pthread_mutex_unlock(&poolIn->mutex);
+	}
+}
+
+
+void cxa_posix_workerPool_waitForIdle(cxa_posix_workerPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	// help out rather than just sitting here
+	cxa_posix_workerPool_task_t currTask;
+	while( takeTask(poolIn, WORKER_INDEX_NONE, &currTask) ) runTask(poolIn, &currTask);
+
+	// now wait for anything still running on the workers
+	if( atomic_load(&poolIn->numPendingTasks) == 0 ) return;
+	pthread_mutex_lock(&poolIn->mutex);
+	while( atomic_load(&poolIn->numPendingTasks) > 0 ) pthread_cond_wait(&poolIn->cond_idle, &poolIn->mutex);
+	pthread_mutex_unlock(&poolIn->mutex);
+}
+
+
+// ******** local function implementations ********
+static void* workerThread(void* argIn)
+{
+	cxa_posix_workerPool_worker_t* worker = (cxa_posix_workerPool_worker_t*)argIn;
+	cxa_posix_workerPool_t* pool = worker->pool;
+	size_t ownIndex = (size_t)(worker - pool->workers);
+
+	while( true )
+	{
+		cxa_posix_workerPool_task_t currTask;
+		if( takeTask(pool, ownIndex, &currTask) )
+		{
+			runTask(pool, &currTask);
+			continue;
+		}
+
+		// nothing to do...sleep until there is. We announce ourselves before
+		// checking for work and submit queues work before checking for sleepers
+		// (both sequentially consistent) so at least one of us sees the other
+		pthread_mutex_lock(&pool->mutex);
+		atomic_fetch_add(&pool->numSleepingWorkers, 1);
+		while( (atomic_load(&pool->numQueuedTasks) == 0) && !pool->shouldExit ) pthread_cond_wait(&pool->cond_workAvailable, &pool->mutex);
+		atomic_fetch_sub(&pool->numSleepingWorkers, 1);
+		bool shouldExit = pool->shouldExit;
+		pthread_mutex_unlock(&pool->mutex);
+
+		if( shouldExit ) break;
+	}
+
+	return NULL;
+}
+
+
+static bool takeTask(cxa_posix_workerPool_t *const poolIn, size_t ownWorkerIndexIn, cxa_posix_workerPool_task_t *const taskOut)
+{
+	// newest work from our own deque first (it's most likely to be cache-hot)
+	bool retVal = (ownWorkerIndexIn != WORKER_INDEX_NONE) && deque_popBack(&poolIn->workers[ownWorkerIndexIn], taskOut);
+
+	// otherwise steal the oldest work from someone else
+	size_t startIndex = (ownWorkerIndexIn != WORKER_INDEX_NONE) ? (ownWorkerIndexIn + 1) : 0;
+	for( size_t i = 0; !retVal && (i < poolIn->numWorkers); i++ )
+	{
+		size_t victimIndex = (startIndex + i) % poolIn->numWorkers;
+		if( victimIndex == ownWorkerIndexIn ) continue;
+
+		retVal = deque_popFront(&poolIn->workers[victimIndex], taskOut);
+	}
+
+	if( retVal ) atomic_fetch_sub(&poolIn->numQueuedTasks, 1);
+
+	return retVal;
+}
+
+
+static void runTask(cxa_posix_workerPool_t *const poolIn, cxa_posix_workerPool_task_t *const taskIn)
+{
+	taskIn->cb(taskIn->userVar);
+
+	// only the last task out needs to wake waitForIdle
+	if( atomic_fetch_sub(&poolIn->numPendingTasks, 1) == 1 )
+	{
+		pthread_mutex_lock(&poolIn->mutex);
+		pthread_cond_broadcast(&poolIn->cond_idle);
+		pthread_mutex_unlock(&poolIn->mutex);
+	}
+}
+
+
+static bool deque_pushBack(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskIn)
+{
+	bool retVal = false;
+
+	pthread_mutex_lock(&workerIn->dequeMutex);
+	if( workerIn->dequeSize < CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER )
+	{
+		workerIn->deque[(workerIn->dequeHead + workerIn->dequeSize) % CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER] = *taskIn;
+		workerIn->dequeSize++;
+		retVal = true;
+	}
+	pthread_mutex_unlock(&workerIn->dequeMutex);
+
+	return retVal;
+}
+
+
+static bool deque_popBack(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskOut)
+{
+	bool retVal = false;
+
+	pthread_mutex_lock(&workerIn->dequeMutex);
+	if( workerIn->dequeSize > 0 )
+	{
+		workerIn->dequeSize--;
+		*taskOut = workerIn->deque[(workerIn->dequeHead + workerIn->dequeSize) % CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER];
+		retVal = true;
+	}
+	pthread_mutex_unlock(&workerIn->dequeMutex);
+
+	return retVal;
+}
+
+
+static bool deque_popFront(cxa_posix_workerPool_worker_t *const workerIn, cxa_posix_workerPool_task_t *const taskOut)
+{
+	bool retVal = false;
+
+	pthread_mutex_lock(&workerIn->dequeMutex);
+	if( workerIn->dequeSize > 0 )
+	{
+		*taskOut = workerIn->deque[workerIn->dequeHead];
+		workerIn->dequeHead = (workerIn->dequeHead + 1) % CXA_POSIX_WORKERPOOL_MAXNUM_TASKS_PER_WORKER;
+		workerIn->dequeSize--;
+		retVal = true;
+	}
+	pthread_mutex_unlock(&workerIn->dequeMutex);
+
+	return retVal;
+}
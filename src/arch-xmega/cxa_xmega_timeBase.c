@@ -9,6 +9,7 @@
 
 // ******** includes ********
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 
 
 // ******** local macro definitions ********
@@ -22,6 +23,8 @@
 
 // ********  local variable declarations *********
 static cxa_xmega_timer32_t* timer = NULL;
+static uint32_t prevCount_us = 0;
+static uint64_t overflowedTime_us = 0;
 
 
 // ******** global function implementations ********
@@ -50,4 +53,18 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount_ns(void)
+{
+	// extend our 32-bit counter in software (an interrupt calling us mid-way would corrupt the extension)
+	cxa_criticalSection_enter();
+	uint32_t currCount_us = cxa_timeBase_getCount_us();
+	if( currCount_us < prevCount_us ) overflowedTime_us += (uint64_t)cxa_timeBase_getMaxCount_us() + 1;
+	prevCount_us = currCount_us;
+	uint64_t retVal_us = overflowedTime_us + currCount_us;
+	cxa_criticalSection_exit();
+
+	return retVal_us * 1000;
+}
+
+
 // ******** local function implementations ********
@@ -140,13 +140,18 @@ bool cxa_blueGiga_btle_client_sendCommand(cxa_blueGiga_btle_client_t *const btle
 		return false;
 	}
 
-	// setup our packet
+	// setup our packet header (the payload is sent from where it lives)
 	cxa_fixedByteBuffer_clear(&btlecIn->fbb_tx);
 	cxa_fixedByteBuffer_append_uint8(&btlecIn->fbb_tx, CXA_BLUEGIGA_MSGTYPE_COMMAND);
 	cxa_fixedByteBuffer_append_uint8(&btlecIn->fbb_tx, (payloadIn != NULL) ? cxa_fixedByteBuffer_getSize_bytes(payloadIn) : 0);
 	cxa_fixedByteBuffer_append_uint8(&btlecIn->fbb_tx, classIdIn);
 	cxa_fixedByteBuffer_append_uint8(&btlecIn->fbb_tx, methodIdIn);
-	if( payloadIn != NULL ) cxa_fixedByteBuffer_append_fbb(&btlecIn->fbb_tx, payloadIn);
+
+	cxa_bufferChain_t chain_tx;
+	cxa_bufferChain_segment_t chain_tx_segments[2];
+	cxa_bufferChain_initStd(&chain_tx, chain_tx_segments);
+	cxa_bufferChain_append_fbb(&chain_tx, &btlecIn->fbb_tx);
+	if( payloadIn != NULL ) cxa_bufferChain_append_fbb(&chain_tx, payloadIn);
 
 	// mark our inflight request as in-use
 	btlecIn->inFlightRequest.classId = classIdIn;
@@ -154,7 +159,7 @@ bool cxa_blueGiga_btle_client_sendCommand(cxa_blueGiga_btle_client_t *const btle
 	btlecIn->inFlightRequest.cb_onResponse = cb_onResponseIn;
 	btlecIn->inFlightRequest.userVar = userVarIn;
 
-	bool retVal = cxa_protocolParser_writePacket(&btlecIn->protoParse.super, &btlecIn->fbb_tx);
+	bool retVal = cxa_protocolParser_writePacket_chain(&btlecIn->protoParse.super, &chain_tx);
 	if( retVal ) cxa_softWatchDog_kick(&btlecIn->inFlightRequest.watchdog);
 
 	return retVal;
@@ -38,7 +38,7 @@ static bool scm_isInErrorState(cxa_protocolParser_t *const superIn);
 static bool scm_canSetBuffer(cxa_protocolParser_t *const superIn);
 static void scm_gotoIdle(cxa_protocolParser_t *const superIn);
 static void scm_reset(cxa_protocolParser_t *const superIn);
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn);
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn);
 
 static void stateCb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn);
@@ -61,7 +61,7 @@ void cxa_protocolParser_bgapi_init(cxa_protocolParser_bgapi_t *const ppIn, cxa_i
 	cxa_assert(ioStreamIn);
 
 	// initialize our super class
-	cxa_protocolParser_init(&ppIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, scm_writeBytes);
+	cxa_protocolParser_init(&ppIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, NULL, scm_writeChain);
 
 	// setup our state machine
 	cxa_stateMachine_init(&ppIn->stateMachine, "bgapiPP", threadIdIn);
@@ -142,15 +142,16 @@ static void scm_reset(cxa_protocolParser_t *const superIn)
 }
 
 
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn)
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn)
 {
 	cxa_protocolParser_bgapi_t* ppIn = (cxa_protocolParser_bgapi_t*)superIn;
 	cxa_assert(ppIn);
 
-	if( fbbIn == NULL ) return true;
+	if( cxa_bufferChain_getNumSegments(chainIn) == 0 ) return true;
 
-	if( !cxa_ioStream_writeByte(ppIn->super.ioStream, cxa_fixedByteBuffer_getSize_bytes(fbbIn)) ) return false;
-	return cxa_ioStream_writeFixedByteBuffer(ppIn->super.ioStream, fbbIn);
+	// length prefix and data in one write
+	uint8_t header[] = {(uint8_t)cxa_bufferChain_getSize_bytes(chainIn)};
+	return cxa_ioStream_writeBufferChain_framed(ppIn->super.ioStream, header, sizeof(header), chainIn, NULL, 0);
 }
 
 
@@ -0,0 +1,119 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_arena.h"
+
+
+// ******** includes ********
+#include <string.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_arena_init(cxa_arena_t *const arenaIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn)
+{
+	cxa_assert(arenaIn);
+	cxa_assert(bufferLocIn);
+
+	// save our references
+	arenaIn->bufferLoc = (uint8_t*)bufferLocIn;
+	arenaIn->maxSize_bytes = bufferMaxSize_bytesIn;
+
+	arenaIn->currOffset_bytes = 0;
+	arenaIn->highWatermark_bytes = 0;
+}
+
+
+void* cxa_arena_alloc(cxa_arena_t *const arenaIn, const size_t numBytesIn)
+{
+	cxa_assert(arenaIn);
+
+	// align based on the actual address (the buffer itself may not be aligned)
+	uintptr_t currAddr = (uintptr_t)(arenaIn->bufferLoc + arenaIn->currOffset_bytes);
+	size_t padding_bytes = (size_t)((CXA_ARENA_ALIGNMENT_BYTES - (currAddr % CXA_ARENA_ALIGNMENT_BYTES)) % CXA_ARENA_ALIGNMENT_BYTES);
+
+	size_t freeSize_bytes = arenaIn->maxSize_bytes - arenaIn->currOffset_bytes;
+	if( (padding_bytes > freeSize_bytes) || (numBytesIn > (freeSize_bytes - padding_bytes)) ) return NULL;
+
+	void* retVal = arenaIn->bufferLoc + arenaIn->currOffset_bytes + padding_bytes;
+	arenaIn->currOffset_bytes += padding_bytes + numBytesIn;
+	if( arenaIn->currOffset_bytes > arenaIn->highWatermark_bytes ) arenaIn->highWatermark_bytes = arenaIn->currOffset_bytes;
+
+	return retVal;
+}
+
+
+void* cxa_arena_alloc_zeroed(cxa_arena_t *const arenaIn, const size_t numBytesIn)
+{
+	void* retVal = cxa_arena_alloc(arenaIn, numBytesIn);
+	if( retVal != NULL ) memset(retVal, 0, numBytesIn);
+
+	return retVal;
+}
+
+
+cxa_arena_mark_t cxa_arena_getMark(cxa_arena_t *const arenaIn)
+{
+	cxa_assert(arenaIn);
+
+	return arenaIn->currOffset_bytes;
+}
+
+
+void cxa_arena_rewind(cxa_arena_t *const arenaIn, const cxa_arena_mark_t markIn)
+{
+	cxa_assert(arenaIn);
+	cxa_assert_msg((markIn <= arenaIn->currOffset_bytes), "rewind past current position");
+
+	arenaIn->currOffset_bytes = markIn;
+}
+
+
+void cxa_arena_reset(cxa_arena_t *const arenaIn)
+{
+	cxa_assert(arenaIn);
+
+	arenaIn->currOffset_bytes = 0;
+}
+
+
+size_t cxa_arena_getUsedSize_bytes(cxa_arena_t *const arenaIn)
+{
+	cxa_assert(arenaIn);
+
+	return arenaIn->currOffset_bytes;
+}
+
+
+size_t cxa_arena_getFreeSize_bytes(cxa_arena_t *const arenaIn)
+{
+	cxa_assert(arenaIn);
+
+	return arenaIn->maxSize_bytes - arenaIn->currOffset_bytes;
+}
+
+
+size_t cxa_arena_getHighWatermark_bytes(cxa_arena_t *const arenaIn)
+{
+	cxa_assert(arenaIn);
+
+	return arenaIn->highWatermark_bytes;
+}
+
+
+// ******** local function implementations ********
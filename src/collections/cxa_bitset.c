@@ -0,0 +1,334 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_bitset.h"
+
+
+// ******** includes ********
+#include <string.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define BITSET_WORD_INDEX(bitIndexIn)				((bitIndexIn) / CXA_BITSET_BITS_PER_WORD)
+#define BITSET_WORD_BIT(bitIndexIn)				(((cxa_bitset_word_t)1) << ((bitIndexIn) % CXA_BITSET_BITS_PER_WORD))
+#define BITSET_WORD_ALLSET							(~((cxa_bitset_word_t)0))
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static inline size_t countTrailingZeros(cxa_bitset_word_t wordIn);
+static inline size_t countSetBits(cxa_bitset_word_t wordIn);
+static inline cxa_bitset_word_t getValidMask(size_t numBitsIn, size_t wordIndexIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_bitset_init(cxa_bitset_t *const bitsetIn, const size_t numBitsIn, cxa_bitset_word_t *const wordsIn, const size_t wordsSize_bytesIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(wordsIn);
+	cxa_assert_msg((CXA_BITSET_NUMWORDS(numBitsIn) <= (wordsSize_bytesIn / sizeof(*wordsIn))), "words buffer too small");
+
+	// save our references
+	bitsetIn->words = wordsIn;
+	bitsetIn->numWords = CXA_BITSET_NUMWORDS(numBitsIn);
+	bitsetIn->numBits = numBitsIn;
+
+	cxa_bitset_clearAll(bitsetIn);
+}
+
+
+void cxa_bitset_set(cxa_bitset_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	bitsetIn->words[BITSET_WORD_INDEX(indexIn)] |= BITSET_WORD_BIT(indexIn);
+}
+
+
+void cxa_bitset_clear(cxa_bitset_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	bitsetIn->words[BITSET_WORD_INDEX(indexIn)] &= ~BITSET_WORD_BIT(indexIn);
+}
+
+
+void cxa_bitset_assign(cxa_bitset_t *const bitsetIn, const size_t indexIn, const bool valueIn)
+{
+	if( valueIn ) cxa_bitset_set(bitsetIn, indexIn);
+	else cxa_bitset_clear(bitsetIn, indexIn);
+}
+
+
+bool cxa_bitset_test(cxa_bitset_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	return (bitsetIn->words[BITSET_WORD_INDEX(indexIn)] & BITSET_WORD_BIT(indexIn)) != 0;
+}
+
+
+void cxa_bitset_setAll(cxa_bitset_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	// bits past the end of the set are always kept clear
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		bitsetIn->words[i] = getValidMask(bitsetIn->numBits, i);
+	}
+}
+
+
+void cxa_bitset_clearAll(cxa_bitset_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	memset(bitsetIn->words, 0, bitsetIn->numWords * sizeof(*bitsetIn->words));
+}
+
+
+bool cxa_bitset_findNextSet(cxa_bitset_t *const bitsetIn, const size_t startIndexIn, size_t *const indexOut)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexOut);
+
+	if( startIndexIn >= bitsetIn->numBits ) return false;
+
+	// mask off the bits before our start index in the first word
+	size_t currWordIndex = BITSET_WORD_INDEX(startIndexIn);
+	cxa_bitset_word_t currWord = bitsetIn->words[currWordIndex] & ~(BITSET_WORD_BIT(startIndexIn) - 1);
+	while( true )
+	{
+		if( currWord != 0 )
+		{
+			*indexOut = (currWordIndex * CXA_BITSET_BITS_PER_WORD) + countTrailingZeros(currWord);
+			return true;
+		}
+
+		if( ++currWordIndex >= bitsetIn->numWords ) break;
+		currWord = bitsetIn->words[currWordIndex];
+	}
+
+	return false;
+}
+
+
+bool cxa_bitset_findFirstSet(cxa_bitset_t *const bitsetIn, size_t *const indexOut)
+{
+	return cxa_bitset_findNextSet(bitsetIn, 0, indexOut);
+}
+
+
+bool cxa_bitset_findFirstClear(cxa_bitset_t *const bitsetIn, size_t *const indexOut)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexOut);
+
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		cxa_bitset_word_t clearBits = ~bitsetIn->words[i] & getValidMask(bitsetIn->numBits, i);
+		if( clearBits != 0 )
+		{
+			*indexOut = (i * CXA_BITSET_BITS_PER_WORD) + countTrailingZeros(clearBits);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+size_t cxa_bitset_count(cxa_bitset_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	size_t retVal = 0;
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		retVal += countSetBits(bitsetIn->words[i]);
+	}
+
+	return retVal;
+}
+
+
+bool cxa_bitset_isEmpty(cxa_bitset_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		if( bitsetIn->words[i] != 0 ) return false;
+	}
+
+	return true;
+}
+
+
+size_t cxa_bitset_getSize_bits(cxa_bitset_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	return bitsetIn->numBits;
+}
+
+
+#ifdef CXA_BITSET_ATOMIC_ENABLE
+void cxa_bitset_atomic_init(cxa_bitset_atomic_t *const bitsetIn, const size_t numBitsIn, atomic_ulong *const wordsIn, const size_t wordsSize_bytesIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(wordsIn);
+	cxa_assert_msg((CXA_BITSET_NUMWORDS(numBitsIn) <= (wordsSize_bytesIn / sizeof(*wordsIn))), "words buffer too small");
+
+	// save our references
+	bitsetIn->words = wordsIn;
+	bitsetIn->numWords = CXA_BITSET_NUMWORDS(numBitsIn);
+	bitsetIn->numBits = numBitsIn;
+
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		atomic_init(&bitsetIn->words[i], 0);
+	}
+}
+
+
+bool cxa_bitset_atomic_set(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	return (atomic_fetch_or_explicit(&bitsetIn->words[BITSET_WORD_INDEX(indexIn)], BITSET_WORD_BIT(indexIn), memory_order_acq_rel) & BITSET_WORD_BIT(indexIn)) != 0;
+}
+
+
+bool cxa_bitset_atomic_clear(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	return (atomic_fetch_and_explicit(&bitsetIn->words[BITSET_WORD_INDEX(indexIn)], ~BITSET_WORD_BIT(indexIn), memory_order_acq_rel) & BITSET_WORD_BIT(indexIn)) != 0;
+}
+
+
+bool cxa_bitset_atomic_test(cxa_bitset_atomic_t *const bitsetIn, const size_t indexIn)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexIn < bitsetIn->numBits);
+
+	return (atomic_load_explicit(&bitsetIn->words[BITSET_WORD_INDEX(indexIn)], memory_order_acquire) & BITSET_WORD_BIT(indexIn)) != 0;
+}
+
+
+bool cxa_bitset_atomic_claimFirstClear(cxa_bitset_atomic_t *const bitsetIn, size_t *const indexOut)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexOut);
+
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		cxa_bitset_word_t validMask = getValidMask(bitsetIn->numBits, i);
+		cxa_bitset_word_t currWord = atomic_load_explicit(&bitsetIn->words[i], memory_order_relaxed);
+
+		// a failed compare-exchange reloads currWord so we only retry while this word has room
+		cxa_bitset_word_t clearBits;
+		while( (clearBits = (~currWord & validMask)) != 0 )
+		{
+			cxa_bitset_word_t targetBit = clearBits & (~clearBits + 1);
+			if( atomic_compare_exchange_weak_explicit(&bitsetIn->words[i], &currWord, (currWord | targetBit), memory_order_acq_rel, memory_order_relaxed) )
+			{
+				*indexOut = (i * CXA_BITSET_BITS_PER_WORD) + countTrailingZeros(targetBit);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+bool cxa_bitset_atomic_takeFirstSet(cxa_bitset_atomic_t *const bitsetIn, size_t *const indexOut)
+{
+	cxa_assert(bitsetIn);
+	cxa_assert(indexOut);
+
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		cxa_bitset_word_t currWord = atomic_load_explicit(&bitsetIn->words[i], memory_order_relaxed);
+		while( currWord != 0 )
+		{
+			cxa_bitset_word_t targetBit = currWord & (~currWord + 1);
+			if( atomic_compare_exchange_weak_explicit(&bitsetIn->words[i], &currWord, (currWord & ~targetBit), memory_order_acq_rel, memory_order_relaxed) )
+			{
+				*indexOut = (i * CXA_BITSET_BITS_PER_WORD) + countTrailingZeros(targetBit);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+size_t cxa_bitset_atomic_count(cxa_bitset_atomic_t *const bitsetIn)
+{
+	cxa_assert(bitsetIn);
+
+	size_t retVal = 0;
+	for( size_t i = 0; i < bitsetIn->numWords; i++ )
+	{
+		retVal += countSetBits(atomic_load_explicit(&bitsetIn->words[i], memory_order_relaxed));
+	}
+
+	return retVal;
+}
+#endif
+
+
+// ******** local function implementations ********
+static inline size_t countTrailingZeros(cxa_bitset_word_t wordIn)
+{
+	// wordIn must be non-zero
+#ifdef __GNUC__
+	return (size_t)__builtin_ctzl(wordIn);
+#else
+	size_t retVal = 0;
+	while( (wordIn & 1) == 0 )
+	{
+		wordIn >>= 1;
+		retVal++;
+	}
+	return retVal;
+#endif
+}
+
+
+static inline size_t countSetBits(cxa_bitset_word_t wordIn)
+{
+#ifdef __GNUC__
+	return (size_t)__builtin_popcountl(wordIn);
+#else
+	size_t retVal = 0;
+	for( ; wordIn != 0; retVal++ ) wordIn &= wordIn - 1;
+	return retVal;
+#endif
+}
+
+
+static inline cxa_bitset_word_t getValidMask(size_t numBitsIn, size_t wordIndexIn)
+{
+	size_t numBitsInWord = numBitsIn - (wordIndexIn * CXA_BITSET_BITS_PER_WORD);
+	return (numBitsInWord >= CXA_BITSET_BITS_PER_WORD) ? BITSET_WORD_ALLSET : (BITSET_WORD_BIT(numBitsInWord) - 1);
+}
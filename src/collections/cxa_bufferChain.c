@@ -0,0 +1,133 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_bufferChain.h"
+
+
+// ******** includes ********
+#include <string.h>
+#include <cxa_assert.h>
+#include <cxa_numberUtils.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_bufferChain_init(cxa_bufferChain_t *const chainIn, cxa_bufferChain_segment_t *const segmentsIn, const size_t segmentsSize_bytesIn)
+{
+	cxa_assert(chainIn);
+	cxa_assert(segmentsIn);
+
+	// setup our internal state
+	cxa_array_init(&chainIn->segments, sizeof(*segmentsIn), segmentsIn, segmentsSize_bytesIn);
+	chainIn->totalSize_bytes = 0;
+}
+
+
+bool cxa_bufferChain_append(cxa_bufferChain_t *const chainIn, void *const dataIn, const size_t numBytesIn)
+{
+	cxa_assert(chainIn);
+
+	if( numBytesIn == 0 ) return true;
+	cxa_assert(dataIn);
+
+	cxa_bufferChain_segment_t newSegment = {.data=dataIn, .size_bytes=numBytesIn};
+	if( !cxa_array_append(&chainIn->segments, &newSegment) ) return false;
+	chainIn->totalSize_bytes += numBytesIn;
+
+	return true;
+}
+
+
+bool cxa_bufferChain_append_fbb(cxa_bufferChain_t *const chainIn, cxa_fixedByteBuffer_t *const fbbIn)
+{
+	cxa_assert(chainIn);
+	cxa_assert(fbbIn);
+
+	return cxa_bufferChain_append(chainIn, cxa_fixedByteBuffer_get_pointerToStartOfData(fbbIn), cxa_fixedByteBuffer_getSize_bytes(fbbIn));
+}
+
+
+bool cxa_bufferChain_append_chain(cxa_bufferChain_t *const chainIn, cxa_bufferChain_t *const sourceChainIn)
+{
+	cxa_assert(chainIn);
+	cxa_assert(sourceChainIn);
+
+	// all or nothing
+	if( cxa_array_getFreeSize_elems(&chainIn->segments) < cxa_bufferChain_getNumSegments(sourceChainIn) ) return false;
+
+	cxa_bufferChain_iterate(sourceChainIn, currSegment)
+	{
+		if( !cxa_bufferChain_append(chainIn, currSegment->data, currSegment->size_bytes) ) return false;
+	}
+
+	return true;
+}
+
+
+size_t cxa_bufferChain_copyTo(cxa_bufferChain_t *const chainIn, void *const bufferOut, const size_t maxSize_bytesIn)
+{
+	cxa_assert(chainIn);
+	cxa_assert(bufferOut);
+
+	size_t numBytesCopied = 0;
+	cxa_bufferChain_iterate(chainIn, currSegment)
+	{
+		size_t numBytesToCopy = CXA_MIN(currSegment->size_bytes, (maxSize_bytesIn - numBytesCopied));
+		memcpy(((uint8_t*)bufferOut) + numBytesCopied, currSegment->data, numBytesToCopy);
+		numBytesCopied += numBytesToCopy;
+
+		if( numBytesCopied == maxSize_bytesIn ) break;
+	}
+
+	return numBytesCopied;
+}
+
+
+cxa_bufferChain_segment_t* cxa_bufferChain_getSegment_atIndex(cxa_bufferChain_t *const chainIn, const size_t indexIn)
+{
+	cxa_assert(chainIn);
+
+	return (cxa_bufferChain_segment_t*)cxa_array_get(&chainIn->segments, indexIn);
+}
+
+
+size_t cxa_bufferChain_getNumSegments(cxa_bufferChain_t *const chainIn)
+{
+	cxa_assert(chainIn);
+
+	return cxa_array_getSize_elems(&chainIn->segments);
+}
+
+
+size_t cxa_bufferChain_getSize_bytes(cxa_bufferChain_t *const chainIn)
+{
+	cxa_assert(chainIn);
+
+	return chainIn->totalSize_bytes;
+}
+
+
+void cxa_bufferChain_clear(cxa_bufferChain_t *const chainIn)
+{
+	cxa_assert(chainIn);
+
+	cxa_array_clear(&chainIn->segments);
+	chainIn->totalSize_bytes = 0;
+}
+
+
+// ******** local function implementations ********
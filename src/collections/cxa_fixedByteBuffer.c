@@ -20,6 +20,9 @@
 
 
 // ******** local function prototypes ********
+static inline uint8_t* getData(cxa_fixedByteBuffer_t *const fbbIn);
+static inline size_t getHeadroom(cxa_fixedByteBuffer_t *const fbbIn);
+static inline void setDataStart(cxa_fixedByteBuffer_t *const fbbIn, uint8_t *const newStartIn);
 
 
 // ********  local variable declarations *********
@@ -27,12 +30,21 @@
 
 // ******** global function implementations ********
 void cxa_fixedByteBuffer_init(cxa_fixedByteBuffer_t *const fbbIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn)
+{
+	cxa_fixedByteBuffer_init_withHeadroom(fbbIn, bufferLocIn, bufferMaxSize_bytesIn, 0);
+}
+
+
+void cxa_fixedByteBuffer_init_withHeadroom(cxa_fixedByteBuffer_t *const fbbIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn, const size_t headroom_bytesIn)
 {
 	cxa_assert(fbbIn);
 	cxa_assert(bufferLocIn);
+	cxa_assert(headroom_bytesIn <= bufferMaxSize_bytesIn);
 
 	// setup our internal state
-	cxa_array_init(&fbbIn->bytes, 1, bufferLocIn, bufferMaxSize_bytesIn);
+	fbbIn->bufferBase = (uint8_t*)bufferLocIn;
+	fbbIn->initialHeadroom_bytes = headroom_bytesIn;
+	cxa_array_init(&fbbIn->bytes, 1, fbbIn->bufferBase + headroom_bytesIn, bufferMaxSize_bytesIn - headroom_bytesIn);
 }
 
 
@@ -42,6 +54,8 @@ void cxa_fixedByteBuffer_init_inPlace(cxa_fixedByteBuffer_t *const fbbIn, const
 	cxa_assert(bufferLocIn);
 
 	// setup our internal state
+	fbbIn->bufferBase = (uint8_t*)bufferLocIn;
+	fbbIn->initialHeadroom_bytes = 0;
 	cxa_array_init_inPlace(&fbbIn->bytes, 1, currNumElemsIn, bufferLocIn, bufferMaxSize_bytesIn);
 }
 
@@ -53,7 +67,9 @@ void cxa_fixedByteBuffer_init_subBufferFixedSize(cxa_fixedByteBuffer_t *const su
 	cxa_assert( (startIndexIn + numBytesIn) <= cxa_fixedByteBuffer_getSize_bytes(parentFbbIn) );
 
 	// setup our internal state
-	cxa_array_init_inPlace(&subFbbIn->bytes, 1, numBytesIn, cxa_array_get(&parentFbbIn->bytes, startIndexIn), numBytesIn);
+	cxa_array_init_inPlace(&subFbbIn->bytes, 1, numBytesIn, cxa_array_get_noBoundsCheck(&parentFbbIn->bytes, startIndexIn), numBytesIn);
+	subFbbIn->bufferBase = (uint8_t*)subFbbIn->bytes.bufferLoc;
+	subFbbIn->initialHeadroom_bytes = 0;
 }
 
 
@@ -66,6 +82,8 @@ void cxa_fixedByteBuffer_init_subBufferRemainingElems(cxa_fixedByteBuffer_t *con
 	// setup our internal state
 	size_t numElems = cxa_fixedByteBuffer_getSize_bytes(parentFbbIn) - startIndexIn;
 	cxa_array_init_inPlace(&subFbbIn->bytes, 1, numElems, cxa_array_get_noBoundsCheck(&parentFbbIn->bytes, startIndexIn), numElems);
+	subFbbIn->bufferBase = (uint8_t*)subFbbIn->bytes.bufferLoc;
+	subFbbIn->initialHeadroom_bytes = 0;
 }
 
 
@@ -78,6 +96,8 @@ void cxa_fixedByteBuffer_init_subBufferParentMaxSize(cxa_fixedByteBuffer_t *cons
 	// setup our internal state
 	size_t maxSize_bytes = cxa_fixedByteBuffer_getMaxSize_bytes(parentFbbIn) - startIndexIn;
 	cxa_array_init_inPlace(&subFbbIn->bytes, 1, 0, cxa_array_get_noBoundsCheck(&parentFbbIn->bytes, startIndexIn), maxSize_bytes);
+	subFbbIn->bufferBase = (uint8_t*)subFbbIn->bytes.bufferLoc;
+	subFbbIn->initialHeadroom_bytes = 0;
 }
 
 
@@ -86,14 +106,10 @@ bool cxa_fixedByteBuffer_append(cxa_fixedByteBuffer_t *const fbbIn, uint8_t *con
 	cxa_assert(fbbIn);
 	cxa_assert(ptrIn);
 
-	// make sure we have room for the operation
-	if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return false;
-
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		if( !cxa_array_append(&fbbIn->bytes, &(ptrIn[i])) ) return false;
-	}
+	uint8_t* dest = cxa_fixedByteBuffer_append_emptyBytes(fbbIn, numBytesIn);
+	if( dest == NULL ) return false;
 
+	memcpy(dest, ptrIn, numBytesIn);
 	return true;
 }
 
@@ -121,12 +137,9 @@ void* cxa_fixedByteBuffer_append_emptyBytes(cxa_fixedByteBuffer_t *const fbbIn,
 	// make sure we have room for the operation
 	if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return NULL;
 
-	void* retVal = cxa_fixedByteBuffer_get_pointerToIndex(fbbIn, cxa_fixedByteBuffer_getSize_bytes(fbbIn));
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		// shouldn't happen, but we should test
-		if( !cxa_array_append_empty(&fbbIn->bytes) ) return NULL;
-	}
+	void* retVal = getData(fbbIn) + fbbIn->bytes.insertIndex;
+	fbbIn->bytes.insertIndex += numBytesIn;
+
 	return retVal;
 }
 
@@ -151,12 +164,22 @@ bool cxa_fixedByteBuffer_remove(cxa_fixedByteBuffer_t *const fbbIn, const size_t
 	cxa_assert(fbbIn);
 
 	// make sure we have room for the operation
-	if( (indexIn + numBytesIn) > cxa_fixedByteBuffer_getSize_bytes(fbbIn) ) return false;
+	size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(fbbIn);
+	if( (indexIn + numBytesIn) > currSize_bytes ) return false;
 
-	for( size_t i = 0; i < numBytesIn; i++ )
+	uint8_t* data = getData(fbbIn);
+	size_t numTrailingBytes = currSize_bytes - indexIn - numBytesIn;
+	if( (indexIn < numTrailingBytes) && ((getHeadroom(fbbIn) + numBytesIn) <= fbbIn->initialHeadroom_bytes) )
+	{
+		// cheaper to move the leading bytes up (giving back headroom we used for a prepend)
+		memmove(data + numBytesIn, data, indexIn);
+		setDataStart(fbbIn, data + numBytesIn);
+	}
+	else
 	{
-		if( !cxa_array_remove_atIndex(&fbbIn->bytes, indexIn) ) return false;
+		memmove(data + indexIn, data + indexIn + numBytesIn, numTrailingBytes);
 	}
+	fbbIn->bytes.insertIndex -= numBytesIn;
 
 	return true;
 }
@@ -331,16 +354,28 @@ bool cxa_fixedByteBuffer_insert(cxa_fixedByteBuffer_t *const fbbIn, const size_t
 	cxa_assert(fbbIn);
 	cxa_assert(ptrIn);
 
-	// make sure we have room for the operation
-	if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return false;
-
 	// make sure the index is in bounds
-	if( indexIn > cxa_fixedByteBuffer_getSize_bytes(fbbIn) ) return false;
+	size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(fbbIn);
+	if( indexIn > currSize_bytes ) return false;
 
-	for( size_t i = 0; i < numBytesIn; i++ )
+	uint8_t* data = getData(fbbIn);
+	size_t numTrailingBytes = currSize_bytes - indexIn;
+	if( (getHeadroom(fbbIn) >= numBytesIn) && (indexIn < numTrailingBytes) )
 	{
-		if( !cxa_array_insert(&fbbIn->bytes, indexIn+i, (void*)&(ptrIn[i])) ) return false;
+		// cheaper to grow backwards into our headroom (only the leading bytes move)
+		memmove(data - numBytesIn, data, indexIn);
+		data -= numBytesIn;
+		setDataStart(fbbIn, data);
 	}
+	else
+	{
+		// make sure we have room for the operation
+		if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return false;
+
+		memmove(data + indexIn + numBytesIn, data + indexIn, numTrailingBytes);
+	}
+	memcpy(data + indexIn, ptrIn, numBytesIn);
+	fbbIn->bytes.insertIndex += numBytesIn;
 
 	return true;
 }
@@ -396,8 +431,38 @@ void cxa_fixedByteBuffer_clear(cxa_fixedByteBuffer_t *const fbbIn)
 {
 	cxa_assert(fbbIn);
 
+	setDataStart(fbbIn, fbbIn->bufferBase + fbbIn->initialHeadroom_bytes);
 	cxa_array_clear(&fbbIn->bytes);
 }
 
 
+size_t cxa_fixedByteBuffer_getHeadroom_bytes(cxa_fixedByteBuffer_t *const fbbIn)
+{
+	cxa_assert(fbbIn);
+
+	return getHeadroom(fbbIn);
+}
+
+
 // ******** local function implementations ********
+static inline uint8_t* getData(cxa_fixedByteBuffer_t *const fbbIn)
+{
+	return (uint8_t*)fbbIn->bytes.bufferLoc;
+}
+
+
+static inline size_t getHeadroom(cxa_fixedByteBuffer_t *const fbbIn)
+{
+	return (size_t)(getData(fbbIn) - fbbIn->bufferBase);
+}
+
+
+static inline void setDataStart(cxa_fixedByteBuffer_t *const fbbIn, uint8_t *const newStartIn)
+{
+	// the end of our buffer never moves, so our max size tracks the start of our data
+	// (headroom used by a prepend counts toward both our size and max size)
+	uint8_t* bufferEnd = getData(fbbIn) + fbbIn->bytes.maxNumElements;
+
+	fbbIn->bytes.bufferLoc = newStartIn;
+	fbbIn->bytes.maxNumElements = (size_t)(bufferEnd - newStartIn);
+}
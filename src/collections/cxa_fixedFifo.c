@@ -14,12 +14,34 @@
 
 
 // ******** local macro definitions ********
+#ifdef CXA_FF_SPSC_ENABLE
+	// our own index is only ever written by us, in an SPSC FIFO the other side's
+	// index must be observed with acquire (and ours published with release) so the
+	// element contents are visible before the index that covers them
+	#define INDEX_LOAD_OWN(fifoIn, idxNameIn)			atomic_load_explicit(&(fifoIn)->idxNameIn, memory_order_relaxed)
+	#define INDEX_LOAD_OTHER(fifoIn, idxNameIn)			((fifoIn)->isSpsc ? atomic_load_explicit(&(fifoIn)->idxNameIn, memory_order_acquire) : \
+															atomic_load_explicit(&(fifoIn)->idxNameIn, memory_order_relaxed))
+	#define INDEX_STORE(fifoIn, idxNameIn, valIn)		do{ if( (fifoIn)->isSpsc ) atomic_store_explicit(&(fifoIn)->idxNameIn, (valIn), memory_order_release); \
+															else atomic_store_explicit(&(fifoIn)->idxNameIn, (valIn), memory_order_relaxed); }while(0)
+#else
+	#define INDEX_LOAD_OWN(fifoIn, idxNameIn)			((fifoIn)->idxNameIn)
+	#define INDEX_LOAD_OTHER(fifoIn, idxNameIn)			((fifoIn)->idxNameIn)
+	#define INDEX_STORE(fifoIn, idxNameIn, valIn)		((fifoIn)->idxNameIn = (valIn))
+#endif
 
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
+static inline size_t nextIndex(cxa_fixedFifo_t *const fifoIn, size_t indexIn);
+static inline void* elemAt(cxa_fixedFifo_t *const fifoIn, size_t indexIn);
+static inline size_t advanceIndex(cxa_fixedFifo_t *const fifoIn, size_t indexIn, size_t numElemsIn);
+static inline size_t sizeFromIndices(cxa_fixedFifo_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn);
+static inline size_t contiguousFreeFromIndices(cxa_fixedFifo_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn);
+#if CXA_FF_MAX_LISTENERS > 0
+static void notifyNoLongerFull(cxa_fixedFifo_t *const fifoIn);
+#endif
 
 
 // ********  local variable declarations *********
@@ -36,13 +58,16 @@ void cxa_fixedFifo_init(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_onFullActio
 
 	// save our references
 	fifoIn->onFullAction = onFullActionIn;
+	#ifdef CXA_FF_SPSC_ENABLE
+	fifoIn->isSpsc = false;
+	#endif
 	fifoIn->datatypeSize_bytes = datatypeSize_bytesIn;
 	fifoIn->bufferLoc = bufferLocIn;
 	fifoIn->maxNumElements = bufferMaxSize_bytesIn / datatypeSize_bytesIn;
 
 	// set some reasonable defaults
-	fifoIn->insertIndex = 0;
-	fifoIn->removeIndex = 0;
+	INDEX_STORE(fifoIn, insertIndex, 0);
+	INDEX_STORE(fifoIn, removeIndex, 0);
 
 	#if CXA_FF_MAX_LISTENERS > 0
 		// setup our listener array
@@ -51,6 +76,20 @@ void cxa_fixedFifo_init(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_onFullActio
 }
 
 
+#ifdef CXA_FF_SPSC_ENABLE
+void cxa_fixedFifo_initSpsc(cxa_fixedFifo_t *const fifoIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn)
+{
+	// a dequeue-on-full would have the producer modify the consumer's index
+	cxa_fixedFifo_init(fifoIn, CXA_FF_ON_FULL_DROP, datatypeSize_bytesIn, bufferLocIn, bufferMaxSize_bytesIn);
+
+	// publish our (zeroed) indices with release from here on
+	fifoIn->isSpsc = true;
+	INDEX_STORE(fifoIn, insertIndex, 0);
+	INDEX_STORE(fifoIn, removeIndex, 0);
+}
+#endif
+
+
 #if CXA_FF_MAX_LISTENERS > 0
 void cxa_fixedFifo_addListener(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_cb_noLongerFull_t cb_noLongerFull, void* userVarIn)
 {
@@ -66,8 +105,8 @@ void cxa_fixedFifo_clear(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
 
-	fifoIn->insertIndex = 0;
-	fifoIn->removeIndex = 0;
+	INDEX_STORE(fifoIn, insertIndex, 0);
+	INDEX_STORE(fifoIn, removeIndex, 0);
 }
 
 
@@ -76,8 +115,11 @@ bool cxa_fixedFifo_queue(cxa_fixedFifo_t *const fifoIn, void *const elemIn)
 	cxa_assert(fifoIn);
 	cxa_assert(elemIn);
 
+	size_t insertIndex = INDEX_LOAD_OWN(fifoIn, insertIndex);
+	size_t newInsertIndex = nextIndex(fifoIn, insertIndex);
+
 	// if we're full, figure out what we should do
-	if( cxa_fixedFifo_isFull(fifoIn) )
+	if( newInsertIndex == INDEX_LOAD_OTHER(fifoIn, removeIndex) )
 	{
 		switch( fifoIn->onFullAction )
 		{
@@ -91,9 +133,8 @@ bool cxa_fixedFifo_queue(cxa_fixedFifo_t *const fifoIn, void *const elemIn)
 	}
 
 	// if we made it here, we should add our element
-	memcpy((void*)(((uint8_t*)fifoIn->bufferLoc) + (fifoIn->insertIndex * fifoIn->datatypeSize_bytes)), elemIn, fifoIn->datatypeSize_bytes);
-	size_t newInsertIndex = fifoIn->insertIndex + 1;
-	fifoIn->insertIndex = (newInsertIndex >= fifoIn->maxNumElements) ? 0 : newInsertIndex;
+	memcpy(elemAt(fifoIn, insertIndex), elemIn, fifoIn->datatypeSize_bytes);
+	INDEX_STORE(fifoIn, insertIndex, newInsertIndex);
 
 	return true;
 }
@@ -103,8 +144,10 @@ bool cxa_fixedFifo_peek(cxa_fixedFifo_t *const fifoIn, void *elemOut)
 {
 	cxa_assert(fifoIn);
 
+	size_t removeIndex = INDEX_LOAD_OWN(fifoIn, removeIndex);
+
 	// if we're empty, we have nothing to return
-	if( cxa_fixedFifo_isEmpty(fifoIn) )
+	if( removeIndex == INDEX_LOAD_OTHER(fifoIn, insertIndex) )
 	{
 		return false;
 	}
@@ -112,7 +155,7 @@ bool cxa_fixedFifo_peek(cxa_fixedFifo_t *const fifoIn, void *elemOut)
 	// if we made it here, we should return our element
 	if( elemOut != NULL )
 	{
-		memcpy(elemOut, (const void*)(((uint8_t*)fifoIn->bufferLoc) + (fifoIn->removeIndex * fifoIn->datatypeSize_bytes)), fifoIn->datatypeSize_bytes);
+		memcpy(elemOut, elemAt(fifoIn, removeIndex), fifoIn->datatypeSize_bytes);
 	}
 
 	return true;
@@ -123,35 +166,28 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut)
 {
 	cxa_assert(fifoIn);
 
-	#if CXA_FF_MAX_LISTENERS > 0
-		bool wasFull = cxa_fixedFifo_isFull(fifoIn);
-	#endif
+	size_t removeIndex = INDEX_LOAD_OWN(fifoIn, removeIndex);
+	size_t insertIndex = INDEX_LOAD_OTHER(fifoIn, insertIndex);
 
 	// if we're empty, we have nothing to return
-	if( cxa_fixedFifo_isEmpty(fifoIn) )
+	if( removeIndex == insertIndex )
 	{
 		return false;
 	}
 
+	#if CXA_FF_MAX_LISTENERS > 0
+		bool wasFull = (nextIndex(fifoIn, insertIndex) == removeIndex);
+	#endif
+
 	// if we made it here, we should return our element
 	if( elemOut != NULL )
 	{
-		memcpy(elemOut, (const void*)(((uint8_t*)fifoIn->bufferLoc) + (fifoIn->removeIndex * fifoIn->datatypeSize_bytes)), fifoIn->datatypeSize_bytes);
+		memcpy(elemOut, elemAt(fifoIn, removeIndex), fifoIn->datatypeSize_bytes);
 	}
-	size_t newRemoveIndex = fifoIn->removeIndex + 1;
-	fifoIn->removeIndex = (newRemoveIndex >= fifoIn->maxNumElements) ? 0 : newRemoveIndex;
+	INDEX_STORE(fifoIn, removeIndex, nextIndex(fifoIn, removeIndex));
 
 	#if CXA_FF_MAX_LISTENERS > 0
-		// notify our listeners
-		if( wasFull )
-		{
-			cxa_array_iterate(&fifoIn->listeners, currEntry, cxa_fixedFifo_listener_entry_t)
-			{
-				if( currEntry == NULL ) continue;
-
-				if( currEntry->cb_noLongerFull != NULL ) currEntry->cb_noLongerFull(fifoIn, currEntry->userVarIn);
-			}
-		}
+		if( wasFull ) notifyNoLongerFull(fifoIn);
 	#endif
 
 	return true;
@@ -163,13 +199,70 @@ bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn,
 	cxa_assert(fifoIn);
 	cxa_assert(elemsIn);
 
-	// simplistic implementation...we can probably make this more efficient
-	for( size_t i = 0; i < numElemsIn; i++ )
+	uint8_t* srcElems = (uint8_t*)elemsIn;
+	bool retVal = true;
+
+	size_t insertIndex = INDEX_LOAD_OWN(fifoIn, insertIndex);
+	size_t numFree = (fifoIn->maxNumElements - 1) - sizeFromIndices(fifoIn, insertIndex, INDEX_LOAD_OTHER(fifoIn, removeIndex));
+
+	// if we won't fit, figure out what we should do
+	if( numElemsIn > numFree )
 	{
-		if( !cxa_fixedFifo_queue(fifoIn, &(((uint8_t*)elemsIn)[i*fifoIn->datatypeSize_bytes])) ) return false;
+		switch( fifoIn->onFullAction )
+		{
+			case CXA_FF_ON_FULL_DEQUEUE:
+				// only the newest elements would survive anyways
+				if( numElemsIn > (fifoIn->maxNumElements - 1) )
+				{
+					srcElems += (numElemsIn - (fifoIn->maxNumElements - 1)) * fifoIn->datatypeSize_bytes;
+					numElemsIn = fifoIn->maxNumElements - 1;
+				}
+				cxa_fixedFifo_bulkDequeue(fifoIn, numElemsIn - numFree);
+				break;
+
+			case CXA_FF_ON_FULL_DROP:
+				// queue what we can
+				numElemsIn = numFree;
+				retVal = false;
+				break;
+		}
 	}
 
-	return true;
+	// copy up to the end of the buffer, then whatever wrapped around to the front
+	size_t numFirstSegment = fifoIn->maxNumElements - insertIndex;
+	if( numFirstSegment > numElemsIn ) numFirstSegment = numElemsIn;
+
+	memcpy(elemAt(fifoIn, insertIndex), srcElems, numFirstSegment * fifoIn->datatypeSize_bytes);
+	if( numElemsIn > numFirstSegment )
+	{
+		memcpy(elemAt(fifoIn, 0), srcElems + (numFirstSegment * fifoIn->datatypeSize_bytes), (numElemsIn - numFirstSegment) * fifoIn->datatypeSize_bytes);
+	}
+	INDEX_STORE(fifoIn, insertIndex, advanceIndex(fifoIn, insertIndex, numElemsIn));
+
+	return retVal;
+}
+
+
+size_t cxa_fixedFifo_bulkQueue_reserve(cxa_fixedFifo_t *const fifoIn, void **const elemsOut)
+{
+	cxa_assert(fifoIn);
+
+	size_t insertIndex = INDEX_LOAD_OWN(fifoIn, insertIndex);
+
+	if( elemsOut != NULL ) *elemsOut = elemAt(fifoIn, insertIndex);
+
+	return contiguousFreeFromIndices(fifoIn, insertIndex, INDEX_LOAD_OTHER(fifoIn, removeIndex));
+}
+
+
+void cxa_fixedFifo_bulkQueue_commit(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t insertIndex = INDEX_LOAD_OWN(fifoIn, insertIndex);
+	cxa_assert(numElemsIn <= contiguousFreeFromIndices(fifoIn, insertIndex, INDEX_LOAD_OTHER(fifoIn, removeIndex)));
+
+	INDEX_STORE(fifoIn, insertIndex, advanceIndex(fifoIn, insertIndex, numElemsIn));
 }
 
 
@@ -177,13 +270,44 @@ bool cxa_fixedFifo_bulkDequeue(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn)
 {
 	cxa_assert(fifoIn);
 
-	// simplistic implementation...we can probably make this more efficient
-	for( size_t i = 0; i < numElemsIn; i++ )
+	return (cxa_fixedFifo_bulkDequeue_copy(fifoIn, NULL, numElemsIn) == numElemsIn);
+}
+
+
+size_t cxa_fixedFifo_bulkDequeue_copy(cxa_fixedFifo_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = INDEX_LOAD_OWN(fifoIn, removeIndex);
+	size_t insertIndex = INDEX_LOAD_OTHER(fifoIn, insertIndex);
+
+	size_t numElems = sizeFromIndices(fifoIn, insertIndex, removeIndex);
+	if( numElems > maxNumElemsIn ) numElems = maxNumElemsIn;
+	if( numElems == 0 ) return 0;
+
+	#if CXA_FF_MAX_LISTENERS > 0
+		bool wasFull = (nextIndex(fifoIn, insertIndex) == removeIndex);
+	#endif
+
+	// copy up to the end of the buffer, then whatever wrapped around to the front
+	if( elemsOut != NULL )
 	{
-		if( !cxa_fixedFifo_dequeue(fifoIn, NULL) ) return false;
+		size_t numFirstSegment = fifoIn->maxNumElements - removeIndex;
+		if( numFirstSegment > numElems ) numFirstSegment = numElems;
+
+		memcpy(elemsOut, elemAt(fifoIn, removeIndex), numFirstSegment * fifoIn->datatypeSize_bytes);
+		if( numElems > numFirstSegment )
+		{
+			memcpy(((uint8_t*)elemsOut) + (numFirstSegment * fifoIn->datatypeSize_bytes), elemAt(fifoIn, 0), (numElems - numFirstSegment) * fifoIn->datatypeSize_bytes);
+		}
 	}
+	INDEX_STORE(fifoIn, removeIndex, advanceIndex(fifoIn, removeIndex, numElems));
 
-	return true;
+	#if CXA_FF_MAX_LISTENERS > 0
+		if( wasFull ) notifyNoLongerFull(fifoIn);
+	#endif
+
+	return numElems;
 }
 
 
@@ -191,11 +315,14 @@ size_t cxa_fixedFifo_bulkDequeue_peek(cxa_fixedFifo_t *const fifoIn, void **cons
 {
 	cxa_assert(fifoIn);
 
-	if( elemsOut != NULL ) *elemsOut = &(((uint8_t*)fifoIn->bufferLoc)[fifoIn->removeIndex*fifoIn->datatypeSize_bytes]);
+	size_t removeIndex = INDEX_LOAD_OWN(fifoIn, removeIndex);
+	size_t insertIndex = INDEX_LOAD_OTHER(fifoIn, insertIndex);
 
-	return (fifoIn->insertIndex >= fifoIn->removeIndex) ?
-			(fifoIn->insertIndex - fifoIn->removeIndex) :
-			(fifoIn->maxNumElements-fifoIn->removeIndex);
+	if( elemsOut != NULL ) *elemsOut = elemAt(fifoIn, removeIndex);
+
+	return (insertIndex >= removeIndex) ?
+			(insertIndex - removeIndex) :
+			(fifoIn->maxNumElements - removeIndex);
 }
 
 
@@ -203,9 +330,10 @@ size_t cxa_fixedFifo_getSize_elems(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
 
-	return (fifoIn->insertIndex >= fifoIn->removeIndex) ?
-		(fifoIn->insertIndex - fifoIn->removeIndex) :
-		((fifoIn->maxNumElements-fifoIn->removeIndex) + fifoIn->insertIndex);
+	size_t lcl_removeIndex = INDEX_LOAD_OTHER(fifoIn, removeIndex);
+	size_t lcl_insertIndex = INDEX_LOAD_OTHER(fifoIn, insertIndex);
+
+	return sizeFromIndices(fifoIn, lcl_insertIndex, lcl_removeIndex);
 }
 
 
@@ -229,8 +357,8 @@ bool cxa_fixedFifo_isFull(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
 
-	size_t lcl_removeIndex = fifoIn->removeIndex;
-	size_t lcl_insertIndex = fifoIn->insertIndex;
+	size_t lcl_removeIndex = INDEX_LOAD_OTHER(fifoIn, removeIndex);
+	size_t lcl_insertIndex = INDEX_LOAD_OTHER(fifoIn, insertIndex);
 
 	return (lcl_removeIndex != 0) ?
 		((lcl_removeIndex-1) == lcl_insertIndex) :
@@ -242,8 +370,56 @@ bool cxa_fixedFifo_isEmpty(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
 
-	return (fifoIn->insertIndex == fifoIn->removeIndex);
+	return (INDEX_LOAD_OTHER(fifoIn, insertIndex) == INDEX_LOAD_OTHER(fifoIn, removeIndex));
 }
 
 
 // ******** local function implementations ********
+static inline size_t nextIndex(cxa_fixedFifo_t *const fifoIn, size_t indexIn)
+{
+	indexIn++;
+	return (indexIn >= fifoIn->maxNumElements) ? 0 : indexIn;
+}
+
+
+static inline void* elemAt(cxa_fixedFifo_t *const fifoIn, size_t indexIn)
+{
+	return (void*)(((uint8_t*)fifoIn->bufferLoc) + (indexIn * fifoIn->datatypeSize_bytes));
+}
+
+
+static inline size_t advanceIndex(cxa_fixedFifo_t *const fifoIn, size_t indexIn, size_t numElemsIn)
+{
+	indexIn += numElemsIn;
+	return (indexIn >= fifoIn->maxNumElements) ? (indexIn - fifoIn->maxNumElements) : indexIn;
+}
+
+
+static inline size_t sizeFromIndices(cxa_fixedFifo_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn)
+{
+	return (insertIndexIn >= removeIndexIn) ?
+		(insertIndexIn - removeIndexIn) :
+		((fifoIn->maxNumElements-removeIndexIn) + insertIndexIn);
+}
+
+
+static inline size_t contiguousFreeFromIndices(cxa_fixedFifo_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn)
+{
+	// one element is always left empty (so full and empty can be told apart)
+	if( removeIndexIn > insertIndexIn ) return removeIndexIn - insertIndexIn - 1;
+
+	return (fifoIn->maxNumElements - insertIndexIn) - ((removeIndexIn == 0) ? 1 : 0);
+}
+
+
+#if CXA_FF_MAX_LISTENERS > 0
+static void notifyNoLongerFull(cxa_fixedFifo_t *const fifoIn)
+{
+	cxa_array_iterate(&fifoIn->listeners, currEntry, cxa_fixedFifo_listener_entry_t)
+	{
+		if( currEntry == NULL ) continue;
+
+		if( currEntry->cb_noLongerFull != NULL ) currEntry->cb_noLongerFull(fifoIn, currEntry->userVarIn);
+	}
+}
+#endif
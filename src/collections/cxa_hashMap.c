@@ -0,0 +1,267 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_hashMap.h"
+
+
+// ******** includes ********
+#include <string.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define FNV1A_OFFSET_BASIS					2166136261UL
+#define FNV1A_PRIME							16777619UL
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static uint32_t hash_int(uint32_t keyIn);
+static uint32_t hash_str(const char *const keyIn);
+
+static bool keysAreEqual(cxa_hashMap_t *const mapIn, cxa_hashMap_entry_t *const entryIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn);
+static cxa_hashMap_entry_t* findEntry(cxa_hashMap_t *const mapIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn);
+static bool put(cxa_hashMap_t *const mapIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn, void *const valueIn);
+static bool removeEntry(cxa_hashMap_t *const mapIn, cxa_hashMap_entry_t *const entryIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_hashMap_init(cxa_hashMap_t *const mapIn, cxa_hashMap_keyType_t keyTypeIn, cxa_hashMap_entry_t *const entriesIn, const size_t entriesSize_bytesIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert( (keyTypeIn == CXA_HASHMAP_KEYTYPE_INT) ||
+				(keyTypeIn == CXA_HASHMAP_KEYTYPE_STRING) );
+	cxa_assert(entriesIn);
+
+	// save our references
+	mapIn->keyType = keyTypeIn;
+	mapIn->entries = entriesIn;
+	mapIn->maxNumEntries = entriesSize_bytesIn / sizeof(*entriesIn);
+	cxa_assert( (mapIn->maxNumEntries > 0) && (mapIn->maxNumEntries < UINT16_MAX) );
+
+	cxa_hashMap_clear(mapIn);
+}
+
+
+void cxa_hashMap_clear(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	for( size_t i = 0; i < mapIn->maxNumEntries; i++ )
+	{
+		mapIn->entries[i].probeLen = 0;
+	}
+	mapIn->numEntries = 0;
+}
+
+
+bool cxa_hashMap_put_int(cxa_hashMap_t *const mapIn, uint32_t keyIn, void *const valueIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_INT);
+
+	return put(mapIn, hash_int(keyIn), keyIn, NULL, valueIn);
+}
+
+
+bool cxa_hashMap_get_int(cxa_hashMap_t *const mapIn, uint32_t keyIn, void **const valueOut)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_INT);
+
+	cxa_hashMap_entry_t* entry = findEntry(mapIn, hash_int(keyIn), keyIn, NULL);
+	if( entry == NULL ) return false;
+
+	if( valueOut != NULL ) *valueOut = entry->value;
+	return true;
+}
+
+
+bool cxa_hashMap_remove_int(cxa_hashMap_t *const mapIn, uint32_t keyIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_INT);
+
+	return removeEntry(mapIn, findEntry(mapIn, hash_int(keyIn), keyIn, NULL));
+}
+
+
+bool cxa_hashMap_put_str(cxa_hashMap_t *const mapIn, const char *const keyIn, void *const valueIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_STRING);
+	cxa_assert(keyIn);
+
+	return put(mapIn, hash_str(keyIn), 0, keyIn, valueIn);
+}
+
+
+bool cxa_hashMap_get_str(cxa_hashMap_t *const mapIn, const char *const keyIn, void **const valueOut)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_STRING);
+	if( keyIn == NULL ) return false;
+
+	cxa_hashMap_entry_t* entry = findEntry(mapIn, hash_str(keyIn), 0, keyIn);
+	if( entry == NULL ) return false;
+
+	if( valueOut != NULL ) *valueOut = entry->value;
+	return true;
+}
+
+
+bool cxa_hashMap_remove_str(cxa_hashMap_t *const mapIn, const char *const keyIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(mapIn->keyType == CXA_HASHMAP_KEYTYPE_STRING);
+	if( keyIn == NULL ) return false;
+
+	return removeEntry(mapIn, findEntry(mapIn, hash_str(keyIn), 0, keyIn));
+}
+
+
+size_t cxa_hashMap_getSize_elems(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return mapIn->numEntries;
+}
+
+
+size_t cxa_hashMap_getMaxSize_elems(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return mapIn->maxNumEntries;
+}
+
+
+// ******** local function implementations ********
+static uint32_t hash_int(uint32_t keyIn)
+{
+	// murmur3 finalizer...sequential ids (like state ids) spread nicely
+	keyIn ^= keyIn >> 16;
+	keyIn *= 0x85EBCA6BUL;
+	keyIn ^= keyIn >> 13;
+	keyIn *= 0xC2B2AE35UL;
+	keyIn ^= keyIn >> 16;
+
+	return keyIn;
+}
+
+
+static uint32_t hash_str(const char *const keyIn)
+{
+	// FNV-1a
+	uint32_t retVal = FNV1A_OFFSET_BASIS;
+	for( const char* currChar = keyIn; *currChar != 0; currChar++ )
+	{
+		retVal ^= (uint8_t)*currChar;
+		retVal *= FNV1A_PRIME;
+	}
+
+	return retVal;
+}
+
+
+static bool keysAreEqual(cxa_hashMap_t *const mapIn, cxa_hashMap_entry_t *const entryIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn)
+{
+	if( entryIn->hash != hashIn ) return false;
+
+	return (mapIn->keyType == CXA_HASHMAP_KEYTYPE_INT) ?
+			(entryIn->key.intVal == intKeyIn) :
+			(strcmp(entryIn->key.strVal, strKeyIn) == 0);
+}
+
+
+static cxa_hashMap_entry_t* findEntry(cxa_hashMap_t *const mapIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn)
+{
+	size_t index = hashIn % mapIn->maxNumEntries;
+	for( uint16_t probeLen = 1; probeLen <= mapIn->maxNumEntries; probeLen++ )
+	{
+		cxa_hashMap_entry_t* currEntry = &mapIn->entries[index];
+
+		// once we hit an entry that is closer to its home than we'd be,
+		// our key can't be any further along (that's the robin-hood invariant)
+		if( currEntry->probeLen < probeLen ) return NULL;
+		if( keysAreEqual(mapIn, currEntry, hashIn, intKeyIn, strKeyIn) ) return currEntry;
+
+		if( ++index >= mapIn->maxNumEntries ) index = 0;
+	}
+
+	return NULL;
+}
+
+
+static bool put(cxa_hashMap_t *const mapIn, uint32_t hashIn, uint32_t intKeyIn, const char *const strKeyIn, void *const valueIn)
+{
+	// existing key is just a value replacement
+	cxa_hashMap_entry_t* existingEntry = findEntry(mapIn, hashIn, intKeyIn, strKeyIn);
+	if( existingEntry != NULL )
+	{
+		existingEntry->value = valueIn;
+		return true;
+	}
+	if( mapIn->numEntries >= mapIn->maxNumEntries ) return false;
+
+	cxa_hashMap_entry_t newEntry = {.value=valueIn, .hash=hashIn, .probeLen=1};
+	if( mapIn->keyType == CXA_HASHMAP_KEYTYPE_INT ) newEntry.key.intVal = intKeyIn;
+	else newEntry.key.strVal = strKeyIn;
+
+	// walk from our home slot, taking the slot of any entry that is closer
+	// to its home than we are (and carrying it along in our place)
+	size_t index = hashIn % mapIn->maxNumEntries;
+	while( true )
+	{
+		cxa_hashMap_entry_t* currEntry = &mapIn->entries[index];
+
+		if( currEntry->probeLen == 0 )
+		{
+			*currEntry = newEntry;
+			mapIn->numEntries++;
+			return true;
+		}
+		if( currEntry->probeLen < newEntry.probeLen )
+		{
+			cxa_hashMap_entry_t tmpEntry = *currEntry;
+			*currEntry = newEntry;
+			newEntry = tmpEntry;
+		}
+
+		newEntry.probeLen++;
+		if( ++index >= mapIn->maxNumEntries ) index = 0;
+	}
+}
+
+
+static bool removeEntry(cxa_hashMap_t *const mapIn, cxa_hashMap_entry_t *const entryIn)
+{
+	if( entryIn == NULL ) return false;
+
+	// shift following entries back toward their home slots (no tombstones needed)
+	size_t index = (size_t)(entryIn - mapIn->entries);
+	for( size_t i = 1; i < mapIn->maxNumEntries; i++ )
+	{
+		size_t nextIndex = index + 1;
+		if( nextIndex >= mapIn->maxNumEntries ) nextIndex = 0;
+
+		cxa_hashMap_entry_t* nextEntry = &mapIn->entries[nextIndex];
+		if( nextEntry->probeLen <= 1 ) break;
+
+		mapIn->entries[index] = *nextEntry;
+		mapIn->entries[index].probeLen--;
+		index = nextIndex;
+	}
+	mapIn->entries[index].probeLen = 0;
+	mapIn->numEntries--;
+
+	return true;
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_mpmcQueue.h"
+
+
+// ******** includes ********
+#include <string.h>
+#include <stdint.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static inline void* elemAt(cxa_mpmcQueue_t *const queueIn, size_t posIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_mpmcQueue_init(cxa_mpmcQueue_t *const queueIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						cxa_mpmcQueue_seq_t *const seqsIn, const size_t seqsSize_bytesIn)
+{
+	cxa_assert(queueIn);
+	cxa_assert(datatypeSize_bytesIn > 0);
+	cxa_assert(datatypeSize_bytesIn <= bufferMaxSize_bytesIn);
+	cxa_assert(bufferLocIn);
+	cxa_assert(seqsIn);
+
+	size_t numElems = bufferMaxSize_bytesIn / datatypeSize_bytesIn;
+	cxa_assert_msg((numElems & (numElems - 1)) == 0, "number of elements must be a power of 2");
+	cxa_assert((seqsSize_bytesIn / sizeof(*seqsIn)) == numElems);
+
+	// save our references
+	queueIn->bufferLoc = bufferLocIn;
+	queueIn->seqs = seqsIn;
+	queueIn->datatypeSize_bytes = datatypeSize_bytesIn;
+	queueIn->indexMask = numElems - 1;
+
+	// each slot starts out free for the producer whose position matches it
+	for( size_t i = 0; i < numElems; i++ )
+	{
+		atomic_init(&queueIn->seqs[i].sequence, i);
+	}
+	atomic_init(&queueIn->enqueuePos, 0);
+	atomic_init(&queueIn->dequeuePos, 0);
+}
+
+
+bool cxa_mpmcQueue_queue(cxa_mpmcQueue_t *const queueIn, void *const elemIn)
+{
+	cxa_assert(queueIn);
+	cxa_assert(elemIn);
+
+	cxa_mpmcQueue_seq_t* currSeq;
+	size_t pos = atomic_load_explicit(&queueIn->enqueuePos, memory_order_relaxed);
+	while( true )
+	{
+		currSeq = &queueIn->seqs[pos & queueIn->indexMask];
+		size_t seq = atomic_load_explicit(&currSeq->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+		if( diff == 0 )
+		{
+			// slot is free...try to claim it
+			if( atomic_compare_exchange_weak_explicit(&queueIn->enqueuePos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed) ) break;
+		}
+		else if( diff < 0 )
+		{
+			// slot still holds an element from the previous lap...we're full
+			return false;
+		}
+		else
+		{
+			// another producer beat us to it
+			pos = atomic_load_explicit(&queueIn->enqueuePos, memory_order_relaxed);
+		}
+	}
+
+	// if we made it here, the slot is ours
+	memcpy(elemAt(queueIn, pos), elemIn, queueIn->datatypeSize_bytes);
+	atomic_store_explicit(&currSeq->sequence, pos + 1, memory_order_release);
+
+	return true;
+}
+
+
+bool cxa_mpmcQueue_dequeue(cxa_mpmcQueue_t *const queueIn, void *elemOut)
+{
+	cxa_assert(queueIn);
+
+	cxa_mpmcQueue_seq_t* currSeq;
+	size_t pos = atomic_load_explicit(&queueIn->dequeuePos, memory_order_relaxed);
+	while( true )
+	{
+		currSeq = &queueIn->seqs[pos & queueIn->indexMask];
+		size_t seq = atomic_load_explicit(&currSeq->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+		if( diff == 0 )
+		{
+			// slot is full...try to claim it
+			if( atomic_compare_exchange_weak_explicit(&queueIn->dequeuePos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed) ) break;
+		}
+		else if( diff < 0 )
+		{
+			// slot hasn't been filled yet...we're empty
+			return false;
+		}
+		else
+		{
+			// another consumer beat us to it
+			pos = atomic_load_explicit(&queueIn->dequeuePos, memory_order_relaxed);
+		}
+	}
+
+	// if we made it here, the slot is ours
+	if( elemOut != NULL ) memcpy(elemOut, elemAt(queueIn, pos), queueIn->datatypeSize_bytes);
+
+	// free the slot for the producer one lap from now
+	atomic_store_explicit(&currSeq->sequence, pos + queueIn->indexMask + 1, memory_order_release);
+
+	return true;
+}
+
+
+size_t cxa_mpmcQueue_getSize_elems(cxa_mpmcQueue_t *const queueIn)
+{
+	cxa_assert(queueIn);
+
+	size_t dequeuePos = atomic_load_explicit(&queueIn->dequeuePos, memory_order_acquire);
+	size_t enqueuePos = atomic_load_explicit(&queueIn->enqueuePos, memory_order_acquire);
+
+	// consumers may have moved on (and producers refilled) between our reads
+	size_t retVal = enqueuePos - dequeuePos;
+	return (retVal > (queueIn->indexMask + 1)) ? (queueIn->indexMask + 1) : retVal;
+}
+
+
+size_t cxa_mpmcQueue_getMaxSize_elems(cxa_mpmcQueue_t *const queueIn)
+{
+	cxa_assert(queueIn);
+
+	return queueIn->indexMask + 1;
+}
+
+
+bool cxa_mpmcQueue_isEmpty(cxa_mpmcQueue_t *const queueIn)
+{
+	cxa_assert(queueIn);
+
+	return (cxa_mpmcQueue_getSize_elems(queueIn) == 0);
+}
+
+
+// ******** local function implementations ********
+static inline void* elemAt(cxa_mpmcQueue_t *const queueIn, size_t posIn)
+{
+	return (void*)(((uint8_t*)queueIn->bufferLoc) + ((posIn & queueIn->indexMask) * queueIn->datatypeSize_bytes));
+}
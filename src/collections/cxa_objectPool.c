@@ -0,0 +1,169 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_objectPool.h"
+
+
+// ******** includes ********
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define INDEX_NONE						SIZE_MAX
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_objectPool_init(cxa_objectPool_t *const poolIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						 cxa_objectPool_slot_t *const slotsIn, const size_t slotsSize_bytesIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(datatypeSize_bytesIn > 0);
+	cxa_assert(datatypeSize_bytesIn <= bufferMaxSize_bytesIn);
+	cxa_assert(bufferLocIn);
+	cxa_assert(slotsIn);
+
+	// save our references
+	poolIn->bufferLoc = bufferLocIn;
+	poolIn->slots = slotsIn;
+	poolIn->datatypeSize_bytes = datatypeSize_bytesIn;
+	poolIn->maxNumElements = bufferMaxSize_bytesIn / datatypeSize_bytesIn;
+	cxa_assert((slotsSize_bytesIn / sizeof(*slotsIn)) == poolIn->maxNumElements);
+
+	// chain everything together (in order, so we hand out the lowest indices first)
+	for( size_t i = 0; i < poolIn->maxNumElements; i++ )
+	{
+		poolIn->slots[i].refCount = 0;
+		poolIn->slots[i].nextFreeIndex = ((i + 1) < poolIn->maxNumElements) ? (i + 1) : INDEX_NONE;
+	}
+	poolIn->freeHeadIndex = 0;
+	poolIn->numInUse = 0;
+	poolIn->highWatermark = 0;
+}
+
+
+void* cxa_objectPool_reserve(cxa_objectPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	if( poolIn->freeHeadIndex == INDEX_NONE ) return NULL;
+
+	// pop from the head of the free list
+	size_t index = poolIn->freeHeadIndex;
+	cxa_objectPool_slot_t* slot = &poolIn->slots[index];
+	poolIn->freeHeadIndex = slot->nextFreeIndex;
+
+	slot->nextFreeIndex = INDEX_NONE;
+	slot->refCount = 1;
+
+	poolIn->numInUse++;
+	if( poolIn->numInUse > poolIn->highWatermark ) poolIn->highWatermark = poolIn->numInUse;
+
+	return cxa_objectPool_getObject_atIndex(poolIn, index);
+}
+
+
+void cxa_objectPool_retain(cxa_objectPool_t *const poolIn, void *const objIn)
+{
+	cxa_assert(poolIn);
+
+	cxa_objectPool_slot_t* slot = &poolIn->slots[cxa_objectPool_getIndex(poolIn, objIn)];
+	cxa_assert( (slot->refCount > 0) && (slot->refCount < UINT8_MAX) );
+
+	slot->refCount++;
+}
+
+
+bool cxa_objectPool_release(cxa_objectPool_t *const poolIn, void *const objIn)
+{
+	cxa_assert(poolIn);
+
+	size_t index = cxa_objectPool_getIndex(poolIn, objIn);
+	cxa_objectPool_slot_t* slot = &poolIn->slots[index];
+
+	if( slot->refCount == 0 ) return false;
+	if( --slot->refCount > 0 ) return true;
+
+	// push onto the head of the free list (so it's the next one out, while it's still cache-hot)
+	slot->nextFreeIndex = poolIn->freeHeadIndex;
+	poolIn->freeHeadIndex = index;
+	poolIn->numInUse--;
+
+	return true;
+}
+
+
+uint8_t cxa_objectPool_getRefCount(cxa_objectPool_t *const poolIn, void *const objIn)
+{
+	cxa_assert(poolIn);
+
+	return poolIn->slots[cxa_objectPool_getIndex(poolIn, objIn)].refCount;
+}
+
+
+bool cxa_objectPool_contains(cxa_objectPool_t *const poolIn, void *const ptrIn)
+{
+	cxa_assert(poolIn);
+
+	uintptr_t start = (uintptr_t)poolIn->bufferLoc;
+	uintptr_t ptr = (uintptr_t)ptrIn;
+	if( (ptr < start) || (ptr >= (start + (poolIn->maxNumElements * poolIn->datatypeSize_bytes))) ) return false;
+
+	return (((ptr - start) % poolIn->datatypeSize_bytes) == 0);
+}
+
+
+size_t cxa_objectPool_getIndex(cxa_objectPool_t *const poolIn, void *const objIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(cxa_objectPool_contains(poolIn, objIn));
+
+	return ((uintptr_t)objIn - (uintptr_t)poolIn->bufferLoc) / poolIn->datatypeSize_bytes;
+}
+
+
+void* cxa_objectPool_getObject_atIndex(cxa_objectPool_t *const poolIn, size_t indexIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(indexIn < poolIn->maxNumElements);
+
+	return (void*)(((uint8_t*)poolIn->bufferLoc) + (indexIn * poolIn->datatypeSize_bytes));
+}
+
+
+size_t cxa_objectPool_getNumFree_elems(cxa_objectPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	return poolIn->maxNumElements - poolIn->numInUse;
+}
+
+
+size_t cxa_objectPool_getMaxSize_elems(cxa_objectPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	return poolIn->maxNumElements;
+}
+
+
+size_t cxa_objectPool_getHighWatermark_elems(cxa_objectPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	return poolIn->highWatermark;
+}
+
+
+// ******** local function implementations ********
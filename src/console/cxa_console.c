@@ -25,6 +25,12 @@
 
 
 // ******** local macro definitions ********
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	#define NUM_BUILTIN_COMMANDS				3
+#else
+	#define NUM_BUILTIN_COMMANDS				2
+#endif
+
 #define HEADER_NUM_COLS					40
 #define COMMAND_PROMPT					" > "
 #define ESCAPE							"\x1b"
@@ -56,6 +62,9 @@ static void clearBuffer(void);
 
 static void command_clear(cxa_array_t *const argsIn, cxa_ioStream_t *const ioStreamIn, void* userVarIn);
 static void command_help(cxa_array_t *const argsIn, cxa_ioStream_t *const ioStreamIn, void* userVarIn);
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void command_runLoopProfile(cxa_array_t *const argsIn, cxa_ioStream_t *const ioStreamIn, void* userVarIn);
+#endif
 
 
 // ********  local variable declarations *********
@@ -65,8 +74,8 @@ static cxa_array_t commandBuffer;
 static char commandBuffer_raw[CXA_CONSOLE_COMMAND_BUFFER_LEN_BYTES];
 
 static cxa_array_t commandEntries;
-static commandEntry_t commandEntries_raw[CXA_CONSOLE_MAXNUM_COMMANDS+2];
-// add one for 'clear' and 'help' command
+static commandEntry_t commandEntries_raw[CXA_CONSOLE_MAXNUM_COMMANDS+NUM_BUILTIN_COMMANDS];
+// add one for 'clear' and 'help' (and 'runLoopProf') command
 
 static bool isExecutingCommand = false;
 static bool isPaused = false;
@@ -85,6 +94,9 @@ void cxa_console_init(const char* deviceNameIn, cxa_ioStream_t *const ioStreamIn
 	cxa_array_initStd(&commandEntries, commandEntries_raw);
 	cxa_console_addCommand("clear", "clears the console", NULL, 0, command_clear, NULL);
 	cxa_console_addCommand("help", "prints available commands", NULL, 0, command_help, NULL);
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	cxa_console_addCommand("runLoopProf", "prints run loop entry statistics", NULL, 0, command_runLoopProfile, NULL);
+#endif
 
 	// register for our runLoop
 	cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, NULL);
@@ -407,3 +419,11 @@ static void command_help(cxa_array_t *const argsIn, cxa_ioStream_t *const ioStre
 		}
 	}
 }
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void command_runLoopProfile(cxa_array_t *const argsIn, cxa_ioStream_t *const ioStreamIn, void* userVarIn)
+{
+	cxa_runLoop_profiler_writeReport(ioStreamIn);
+}
+#endif
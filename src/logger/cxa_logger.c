@@ -12,6 +12,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <cxa_assert.h>
+#include <cxa_bufferChain.h>
 #include <cxa_config.h>
 #include <cxa_criticalSection.h>
 #include <cxa_numberUtils.h>
@@ -25,17 +26,44 @@
 
 // ******** local macro definitions ********
 #define CXA_LOGGER_TRUNCATE_STRING			"..."
+#define CXA_LOGGER_PADDING_STRING			"                                "
+
+#ifndef CXA_LOGGER_MAXNUM_RECORD_SEGMENTS
+	#define CXA_LOGGER_MAXNUM_RECORD_SEGMENTS		16
+#endif
 
 
 // ******** local type definitions ********
+/**
+ * All of the pieces of a single log line. They are collected here and
+ * handed to the ioStream in one vectored write (rather than one write
+ * per field).
+ */
+typedef struct
+{
+	cxa_bufferChain_t chain;
+	cxa_bufferChain_segment_t chain_segments[CXA_LOGGER_MAXNUM_RECORD_SEGMENTS];
+
+	// our pointer size plus [0x] plus null-term
+	char timeBuff[sizeof(void*)*2 + 4 + 1];
+	char idBuff[sizeof(void*)*2 + 4 + 1];
+
+	char msgBuff[CXA_IOSTREAM_FORMATTED_BUFFERLEN_BYTES];
+}logRecord_t;
 
 
 // ******** local function prototypes ********
 static void cxa_logger_log_varArgs(cxa_logger_t *const loggerIn, const uint8_t levelIn, const char* formatIn, va_list argsIn);
 static inline void checkSysLogInit(void);
-static void writeField(const char *const stringIn, size_t maxFieldLenIn);
 static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn);
 
+static void logRecord_init(logRecord_t *const recordIn);
+static void logRecord_append(logRecord_t *const recordIn, const char *const bytesIn, size_t numBytesIn);
+static void logRecord_appendField(logRecord_t *const recordIn, const char *const stringIn, size_t maxFieldLenIn);
+static void logRecord_appendHeader(logRecord_t *const recordIn, cxa_logger_t *const loggerIn, const uint8_t levelIn);
+static void logRecord_appendFormatted(logRecord_t *const recordIn, const char* formatIn, va_list argsIn);
+static void logRecord_write(logRecord_t *const recordIn);
+
 
 // ********  local variable declarations *********
 static cxa_logger_t sysLog;
@@ -133,14 +161,17 @@ void cxa_logger_log_untermString_impl(cxa_logger_t *const loggerIn, const uint8_
 #endif
 
 	// common header
-	writeHeader(loggerIn, levelIn);
+	logRecord_t record;
+	logRecord_init(&record);
+	logRecord_appendHeader(&record, loggerIn, levelIn);
 
-	if( prefixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)prefixIn);
-	cxa_ioStream_writeBytes(ioStream, (void *const)untermStringIn, untermStrLen_bytesIn);
-	if( postFixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)postFixIn);
+	if( prefixIn != NULL ) logRecord_append(&record, prefixIn, strlen(prefixIn));
+	logRecord_append(&record, untermStringIn, untermStrLen_bytesIn);
+	if( postFixIn != NULL ) logRecord_append(&record, postFixIn, strlen(postFixIn));
 
-	// print EOL
-	cxa_ioStream_writeString(ioStream, CXA_LINE_ENDING);
+	// EOL, then out the door in one go
+	logRecord_append(&record, CXA_LINE_ENDING, strlen(CXA_LINE_ENDING));
+	logRecord_write(&record);
 
 #ifdef CXA_CONSOLE_ENABLE
 	cxa_console_postlog();
@@ -329,13 +360,16 @@ void cxa_logger_log_varArgs(cxa_logger_t *const loggerIn, const uint8_t levelIn,
 #endif
 
 	// common header
-	writeHeader(loggerIn, levelIn);
+	logRecord_t record;
+	logRecord_init(&record);
+	logRecord_appendHeader(&record, loggerIn, levelIn);
 
 	// now do our VARARGS
-	cxa_ioStream_vWriteString(ioStream, formatIn, argsIn, true, CXA_LOGGER_TRUNCATE_STRING);
+	logRecord_appendFormatted(&record, formatIn, argsIn);
 
-	// print EOL
-	cxa_ioStream_writeBytes(ioStream, (void*)CXA_LINE_ENDING, strlen(CXA_LINE_ENDING));
+	// EOL, then out the door in one go
+	logRecord_append(&record, CXA_LINE_ENDING, strlen(CXA_LINE_ENDING));
+	logRecord_write(&record);
 
 #ifdef CXA_CONSOLE_ENABLE
 	cxa_console_postlog();
@@ -356,27 +390,57 @@ static inline void checkSysLogInit(void)
 }
 
 
-static void writeField(const char *const stringIn, size_t maxFieldLenIn)
+static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
+{
+	logRecord_t record;
+	logRecord_init(&record);
+	logRecord_appendHeader(&record, loggerIn, levelIn);
+	logRecord_write(&record);
+}
+
+
+static void logRecord_init(logRecord_t *const recordIn)
+{
+	cxa_bufferChain_initStd(&recordIn->chain, recordIn->chain_segments);
+}
+
+
+static void logRecord_append(logRecord_t *const recordIn, const char *const bytesIn, size_t numBytesIn)
+{
+	if( cxa_bufferChain_append(&recordIn->chain, (void*)bytesIn, numBytesIn) ) return;
+
+	// out of segments...send what we have so far and keep going
+	logRecord_write(recordIn);
+	cxa_bufferChain_append(&recordIn->chain, (void*)bytesIn, numBytesIn);
+}
+
+
+static void logRecord_appendField(logRecord_t *const recordIn, const char *const stringIn, size_t maxFieldLenIn)
 {
 	size_t stringLen_bytes = strlen(stringIn);
 
 	if( stringLen_bytes > maxFieldLenIn )
 	{
-		cxa_ioStream_writeBytes(ioStream, (void*)stringIn, maxFieldLenIn-strlen(CXA_LOGGER_TRUNCATE_STRING));
-		cxa_ioStream_writeString(ioStream, CXA_LOGGER_TRUNCATE_STRING);
+		logRecord_append(recordIn, stringIn, maxFieldLenIn-strlen(CXA_LOGGER_TRUNCATE_STRING));
+		logRecord_append(recordIn, CXA_LOGGER_TRUNCATE_STRING, strlen(CXA_LOGGER_TRUNCATE_STRING));
 	}
 	else
 	{
-		cxa_ioStream_writeString(ioStream, (char*)stringIn);
-		for( size_t i = stringLen_bytes; i < maxFieldLenIn; i++ )
+		logRecord_append(recordIn, stringIn, stringLen_bytes);
+
+		// pad from a constant string rather than byte-by-byte
+		size_t numPaddingBytes = maxFieldLenIn - stringLen_bytes;
+		while( numPaddingBytes > 0 )
 		{
-			cxa_ioStream_writeByte(ioStream, ' ');
+			size_t currNumPaddingBytes = CXA_MIN(numPaddingBytes, strlen(CXA_LOGGER_PADDING_STRING));
+			logRecord_append(recordIn, CXA_LOGGER_PADDING_STRING, currNumPaddingBytes);
+			numPaddingBytes -= currNumPaddingBytes;
 		}
 	}
 }
 
 
-static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
+static void logRecord_appendHeader(logRecord_t *const recordIn, cxa_logger_t *const loggerIn, const uint8_t levelIn)
 {
 	cxa_assert(loggerIn);
 
@@ -405,26 +469,47 @@ static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
 			break;
 	}
 
-	// our buffer for this go-round max...our pointer size
-	// plus [0x] plus null-term
-	char buff[sizeof(loggerIn)*2 + 4 + 1];
-
 	// print the time (if enabled)
 	#ifdef CXA_LOGGER_TIME_ENABLE
-		snprintf(buff, sizeof(buff), "%-8" PRIx32, cxa_timeBase_getCount_us());
+		snprintf(recordIn->timeBuff, sizeof(recordIn->timeBuff), "%-8" PRIx32, cxa_timeBase_getCount_us());
 		// 32-bit integer +space
-		writeField(buff, 9);
+		logRecord_appendField(recordIn, recordIn->timeBuff, 9);
 	#endif
 
 
 	// print the name
-	writeField(loggerIn->name, largestloggerName_bytes);
+	logRecord_appendField(recordIn, loggerIn->name, largestloggerName_bytes);
 
 	// pointer (id of logger)
-	snprintf(buff, sizeof(buff), "[%p]", loggerIn);
-	writeField(buff, 5+(2*sizeof(void*)));
+	snprintf(recordIn->idBuff, sizeof(recordIn->idBuff), "[%p]", loggerIn);
+	logRecord_appendField(recordIn, recordIn->idBuff, 5+(2*sizeof(void*)));
 
 	// level text
-	writeField(levelText, 5);
-	cxa_ioStream_writeByte(ioStream, ' ');
+	logRecord_appendField(recordIn, levelText, 5);
+	logRecord_append(recordIn, " ", 1);
+}
+
+
+static void logRecord_appendFormatted(logRecord_t *const recordIn, const char* formatIn, va_list argsIn)
+{
+	int expectedNumBytes = vsnprintf(recordIn->msgBuff, sizeof(recordIn->msgBuff), formatIn, argsIn);
+	if( expectedNumBytes < 0 ) return;
+
+	if( (size_t)expectedNumBytes < sizeof(recordIn->msgBuff) )
+	{
+		logRecord_append(recordIn, recordIn->msgBuff, (size_t)expectedNumBytes);
+	}
+	else
+	{
+		// doesn't fit...truncate
+		logRecord_append(recordIn, recordIn->msgBuff, sizeof(recordIn->msgBuff)-1);
+		logRecord_append(recordIn, CXA_LOGGER_TRUNCATE_STRING, strlen(CXA_LOGGER_TRUNCATE_STRING));
+	}
+}
+
+
+static void logRecord_write(logRecord_t *const recordIn)
+{
+	cxa_ioStream_writeBufferChain(ioStream, &recordIn->chain);
+	cxa_bufferChain_clear(&recordIn->chain);
 }
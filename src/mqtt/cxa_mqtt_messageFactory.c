@@ -9,8 +9,8 @@
 
 // ******** includes ********
 #include <stddef.h>
-#include <cxa_array.h>
 #include <cxa_assert.h>
+#include <cxa_objectPool.h>
 
 #define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
 #include <cxa_logger_implementation.h>
@@ -22,12 +22,10 @@
 // ******** local type definitions ********
 typedef struct
 {
-	uint8_t refCount;
-
 	cxa_mqtt_message_t msg;
 
 	cxa_fixedByteBuffer_t msgFbb;
-	uint8_t msgBuffer_raw[CXA_MQTT_MESSAGEFACTORY_MESSAGE_SIZE_BYTES];
+	uint8_t msgBuffer_raw[CXA_MQTT_MESSAGEFACTORY_MESSAGE_HEADROOM_BYTES + CXA_MQTT_MESSAGEFACTORY_MESSAGE_SIZE_BYTES];
 }messageEntry_t;
 
 
@@ -39,8 +37,9 @@ static messageEntry_t* getMsgEntryFromMessage(cxa_mqtt_message_t *const msgIn);
 // ********  local variable declarations *********
 static bool isInit = false;
 
-static cxa_array_t msgEntries;
-static messageEntry_t msgEntries_raw[CXA_MQTT_MESSAGEFACTORY_NUM_MESSAGES];
+static cxa_objectPool_t msgPool;
+static messageEntry_t msgPool_entries[CXA_MQTT_MESSAGEFACTORY_NUM_MESSAGES];
+static cxa_objectPool_slot_t msgPool_slots[CXA_MQTT_MESSAGEFACTORY_NUM_MESSAGES];
 
 static cxa_logger_t logger;
 
@@ -50,15 +49,7 @@ size_t cxa_mqtt_messageFactory_getNumFreeMessages(void)
 {
 	initIfNeeded();
 
-	size_t numFreeMessages = 0;
-	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
-	{
-		if( currEntry == NULL ) continue;
-
-		if( currEntry->refCount == 0 ) numFreeMessages++;
-	}
-
-	return numFreeMessages;
+	return cxa_objectPool_getNumFree_elems(&msgPool);
 }
 
 
@@ -66,23 +57,17 @@ cxa_mqtt_message_t* cxa_mqtt_messageFactory_getFreeMessage_empty(void)
 {
 	initIfNeeded();
 
-	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
+	messageEntry_t* newEntry = (messageEntry_t*)cxa_objectPool_reserve(&msgPool);
+	if( newEntry == NULL )
 	{
-		if( currEntry == NULL) continue;
-
-		if( currEntry->refCount == 0 )
-		{
-			currEntry->refCount = 1;
-			cxa_logger_trace(&logger, "message %p newly reserved", &currEntry->msg);
-
-			cxa_fixedByteBuffer_clear(&currEntry->msgFbb);
-			cxa_mqtt_message_initEmpty(&currEntry->msg, &currEntry->msgFbb);
-			return &currEntry->msg;
-		}
+		cxa_logger_warn(&logger, "no free messages!");
+		return NULL;
 	}
+	cxa_logger_trace(&logger, "message %p newly reserved", &newEntry->msg);
 
-	cxa_logger_warn(&logger, "no free messages!");
-	return NULL;
+	cxa_fixedByteBuffer_clear(&newEntry->msgFbb);
+	cxa_mqtt_message_initEmpty(&newEntry->msg, &newEntry->msgFbb);
+	return &newEntry->msg;
 }
 
 
@@ -93,15 +78,11 @@ cxa_mqtt_message_t* cxa_mqtt_messageFactory_getMessage_byBuffer(cxa_fixedByteBuf
 	// simple case (better than an assert in this case)
 	if( fbbIn == NULL) return NULL;
 
-	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
-	{
-		if( currEntry == NULL) continue;
+	// the buffer is embedded in its entry...work backwards to the entry
+	messageEntry_t* targetEntry = (messageEntry_t*)((uintptr_t)fbbIn - offsetof(messageEntry_t, msgFbb));
+	if( !cxa_objectPool_contains(&msgPool, targetEntry) || (cxa_objectPool_getRefCount(&msgPool, targetEntry) == 0) ) return NULL;
 
-		if( (currEntry->refCount != 0) && (&currEntry->msgFbb == fbbIn) ) return &currEntry->msg;
-	}
-
-	// if we made it here, we couldn't find a match
-	return NULL;
+	return &targetEntry->msg;
 }
 
 
@@ -110,10 +91,10 @@ void cxa_mqtt_messageFactory_incrementMessageRefCount(cxa_mqtt_message_t *const
 	initIfNeeded();
 
 	messageEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
-	cxa_assert( targetEntry && (targetEntry->refCount < UINT8_MAX) );
+	cxa_assert(targetEntry);
 
-	targetEntry->refCount++;
-	cxa_logger_trace(&logger, "message %p referenced (%d)", &targetEntry->msg, targetEntry->refCount);
+	cxa_objectPool_retain(&msgPool, targetEntry);
+	cxa_logger_trace(&logger, "message %p referenced (%d)", &targetEntry->msg, cxa_objectPool_getRefCount(&msgPool, targetEntry));
 }
 
 
@@ -125,10 +106,9 @@ void cxa_mqtt_messageFactory_decrementMessageRefCount(cxa_mqtt_message_t *const
 	messageEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
 	cxa_assert(targetEntry);
 
-	if( targetEntry->refCount > 0 )
+	if( cxa_objectPool_release(&msgPool, targetEntry) )
 	{
-		targetEntry->refCount--;
-		cxa_logger_trace(&logger, "message %p dereferenced (%d)", &targetEntry->msg, targetEntry->refCount);
+		cxa_logger_trace(&logger, "message %p dereferenced (%d)", &targetEntry->msg, cxa_objectPool_getRefCount(&msgPool, targetEntry));
 	}
 	else cxa_logger_warn(&logger, "mismatched decrement call for %p", &targetEntry->msg);
 }
@@ -141,7 +121,7 @@ uint8_t cxa_mqtt_messageFactory_getReferenceCountForMessage(cxa_mqtt_message_t *
 	messageEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
 	cxa_assert(targetEntry);
 
-	return targetEntry->refCount;
+	return cxa_objectPool_getRefCount(&msgPool, targetEntry);
 }
 
 
@@ -154,13 +134,10 @@ static void initIfNeeded(void)
 	cxa_logger_init(&logger, "mqttMsgFactory");
 
 	// initialize our messages
-	cxa_array_init_inPlace(&msgEntries, sizeof(*msgEntries_raw), (sizeof(msgEntries_raw)/sizeof(*msgEntries_raw)), (void*)msgEntries_raw, sizeof(msgEntries_raw));
-	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
+	cxa_objectPool_initStd(&msgPool, msgPool_entries, msgPool_slots);
+	for( size_t i = 0; i < (sizeof(msgPool_entries)/sizeof(*msgPool_entries)); i++ )
 	{
-		cxa_assert(currEntry);
-		cxa_fixedByteBuffer_initStd(&currEntry->msgFbb, currEntry->msgBuffer_raw);
-
-		currEntry->refCount = 0;
+		cxa_fixedByteBuffer_initStd_withHeadroom(&msgPool_entries[i].msgFbb, msgPool_entries[i].msgBuffer_raw, CXA_MQTT_MESSAGEFACTORY_MESSAGE_HEADROOM_BYTES);
 	}
 
 
@@ -170,12 +147,8 @@ static void initIfNeeded(void)
 
 static messageEntry_t* getMsgEntryFromMessage(cxa_mqtt_message_t *const msgIn)
 {
-	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
-	{
-		if( currEntry == NULL ) continue;
-
-		if( &currEntry->msg == msgIn ) return currEntry;
-	}
+	// the message is embedded in its entry...work backwards to the entry
+	messageEntry_t* retVal = (messageEntry_t*)((uintptr_t)msgIn - offsetof(messageEntry_t, msg));
 
-	return NULL;
+	return cxa_objectPool_contains(&msgPool, retVal) ? retVal : NULL;
 }
@@ -224,6 +224,10 @@ static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevSta
 	cxa_assert(netClientIn);
 
 	cxa_logger_info(&netClientIn->logger, "connecting to %s::%d", netClientIn->hostname, netClientIn->portNum);
+
+	// anything our header parser read ahead belongs to the previous connection
+	cxa_protocolParser_rxBlock_discard(&netClientIn->headerLineParser.super);
+
 	if( !cxa_network_tcpClient_connectToHost(netClientIn->tcpClient, netClientIn->hostname, netClientIn->portNum, netClientIn->useTls, netClientIn->timeout_ms) )
 	{
 		cxa_logger_warn(&netClientIn->logger, "error initiating connection");
@@ -244,9 +248,17 @@ static void stateCb_sendDefaultHeaders_enter(cxa_stateMachine_t *const smIn, int
 
 	cxa_ioStream_t* ios = cxa_network_tcpClient_getIoStream(netClientIn->tcpClient);
 
-	cxa_ioStream_writeFormattedLine(ios, "POST %s HTTP/1.1", netClientIn->url);
-	cxa_ioStream_writeFormattedLine(ios, "Host: %s", netClientIn->hostname);
-	cxa_ioStream_writeLine(ios, "Content-Type: application/json");
+	// one vectored write for all of the default headers (also avoids
+	// the formatted-string buffer limit for long urls / hostnames)
+	cxa_bufferChain_segment_t headers[] =
+	{
+		{.data=(void*)"POST ", .size_bytes=strlen("POST ")},
+		{.data=(void*)netClientIn->url, .size_bytes=strlen(netClientIn->url)},
+		{.data=(void*)(" HTTP/1.1" CXA_LINE_ENDING "Host: "), .size_bytes=strlen(" HTTP/1.1" CXA_LINE_ENDING "Host: ")},
+		{.data=(void*)netClientIn->hostname, .size_bytes=strlen(netClientIn->hostname)},
+		{.data=(void*)(CXA_LINE_ENDING "Content-Type: application/json" CXA_LINE_ENDING), .size_bytes=strlen(CXA_LINE_ENDING "Content-Type: application/json" CXA_LINE_ENDING)},
+	};
+	cxa_ioStream_writeBytesV(ios, headers, sizeof(headers)/sizeof(*headers));
 
 	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_CALC_USER_BODY);
 }
@@ -418,7 +430,7 @@ static void stateCb_readBody_state(cxa_stateMachine_t *const smIn, void *userVar
 	for( int i = 0; i < MAXNUM_RX_BYTES_PER_ITERATION; i++ )
 	{
 		uint8_t rxByte;
-		cxa_ioStream_readStatus_t readState = cxa_ioStream_readByte(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), &rxByte);
+		cxa_ioStream_readStatus_t readState = cxa_ioStream_readByte(cxa_protocolParser_getPassthroughIoStream(&netClientIn->headerLineParser.super), &rxByte);
 		if( readState == CXA_IOSTREAM_READSTAT_ERROR )
 		{
 			cxa_logger_warn(&netClientIn->logger, "error reading body");
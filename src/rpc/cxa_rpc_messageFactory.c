@@ -8,9 +8,11 @@
 
 
 // ******** includes ********
+#include <stddef.h>
 #include <stdint.h>
 #include <cxa_assert.h>
 #include <cxa_config.h>
+#include <cxa_objectPool.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_DEBUG
 #include <cxa_logger_implementation.h>
@@ -25,8 +27,6 @@
 // ******** local type definitions ********
 typedef struct
 {
-	uint8_t refCount;
-
 	cxa_rpc_message_t msg;
 	cxa_fixedByteBuffer_t msgFbb;
 	uint8_t msg_raw[CXA_RPC_MSGFACTORY_BUFFER_SIZE_BYTES];
@@ -40,7 +40,9 @@ static cxa_rpc_messageFactory_msgEntry_t* getMsgEntryFromMessage(cxa_rpc_message
 // ********  local variable declarations *********
 static bool isInit = false;
 static cxa_logger_t logger;
-static cxa_rpc_messageFactory_msgEntry_t msgPool[CXA_RPC_MSGFACTORY_POOL_NUM_MSGS];
+static cxa_objectPool_t msgPool;
+static cxa_rpc_messageFactory_msgEntry_t msgPool_entries[CXA_RPC_MSGFACTORY_POOL_NUM_MSGS];
+static cxa_objectPool_slot_t msgPool_slots[CXA_RPC_MSGFACTORY_POOL_NUM_MSGS];
 
 
 // ******** global function implementations ********
@@ -52,11 +54,11 @@ void cxa_rpc_messageFactory_init(void)
 	cxa_logger_init(&logger, "rpcMsgFactory");
 
 	// setup our message pool
-	for( size_t i = 0; i < (sizeof(msgPool)/sizeof(*msgPool)); i++ )
+	cxa_objectPool_initStd(&msgPool, msgPool_entries, msgPool_slots);
+	for( size_t i = 0; i < (sizeof(msgPool_entries)/sizeof(*msgPool_entries)); i++ )
 	{
-		cxa_rpc_messageFactory_msgEntry_t* currEntry = (cxa_rpc_messageFactory_msgEntry_t*)&msgPool[i];
+		cxa_rpc_messageFactory_msgEntry_t* currEntry = &msgPool_entries[i];
 
-		currEntry->refCount = 0;
 		cxa_fixedByteBuffer_initStd(&currEntry->msgFbb, currEntry->msg_raw);
 
 		cxa_logger_trace(&logger, "message %p added to pool", &currBuffer->msg);
@@ -70,15 +72,7 @@ size_t cxa_rpc_messageFactory_getNumFreeMessages(void)
 {
 	if( !isInit ) cxa_rpc_messageFactory_init();
 
-	size_t retVal = 0;
-
-	for( size_t i = 0; i < (sizeof(msgPool)/sizeof(*msgPool)); i++ )
-	{
-		cxa_rpc_messageFactory_msgEntry_t* currEntry = (cxa_rpc_messageFactory_msgEntry_t*)&msgPool[i];
-		if( currEntry->refCount == 0 ) retVal++;
-	}
-
-	return retVal;
+	return cxa_objectPool_getNumFree_elems(&msgPool);
 }
 
 
@@ -86,23 +80,17 @@ cxa_rpc_message_t* cxa_rpc_messageFactory_getFreeMessage_empty(void)
 {
 	if( !isInit ) cxa_rpc_messageFactory_init();
 
-	for( size_t i = 0; i < (sizeof(msgPool)/sizeof(*msgPool)); i++ )
+	cxa_rpc_messageFactory_msgEntry_t* newEntry = (cxa_rpc_messageFactory_msgEntry_t*)cxa_objectPool_reserve(&msgPool);
+	if( newEntry == NULL )
 	{
-		cxa_rpc_messageFactory_msgEntry_t* currEntry = (cxa_rpc_messageFactory_msgEntry_t*)&msgPool[i];
-
-		if( currEntry->refCount == 0 )
-		{
-			currEntry->refCount = 1;
-			cxa_logger_trace(&logger, "message %p newly reserved", &currEntry->msg);
-
-			cxa_fixedByteBuffer_clear(&currEntry->msgFbb);
-			cxa_rpc_message_initEmpty(&currEntry->msg, &currEntry->msgFbb);
-			return &currEntry->msg;
-		}
+		cxa_logger_warn(&logger, "no free messages!");
+		return NULL;
 	}
+	cxa_logger_trace(&logger, "message %p newly reserved", &newEntry->msg);
 
-	cxa_logger_warn(&logger, "no free messages!");
-	return NULL;
+	cxa_fixedByteBuffer_clear(&newEntry->msgFbb);
+	cxa_rpc_message_initEmpty(&newEntry->msg, &newEntry->msgFbb);
+	return &newEntry->msg;
 }
 
 
@@ -113,15 +101,11 @@ cxa_rpc_message_t* cxa_rpc_messageFactory_getMessage_byBuffer(cxa_fixedByteBuffe
 	// simple case (better than an assert in this case)
 	if( fbbIn == NULL) return NULL;
 
-	for( size_t i = 0; i < (sizeof(msgPool)/sizeof(*msgPool)); i++ )
-	{
-		cxa_rpc_messageFactory_msgEntry_t* currEntry = (cxa_rpc_messageFactory_msgEntry_t*)&msgPool[i];
-
-		if( (currEntry->refCount != 0) && (&currEntry->msgFbb == fbbIn) ) return &currEntry->msg;
-	}
+	// the buffer is embedded in its entry...work backwards to the entry
+	cxa_rpc_messageFactory_msgEntry_t* targetEntry = (cxa_rpc_messageFactory_msgEntry_t*)((uintptr_t)fbbIn - offsetof(cxa_rpc_messageFactory_msgEntry_t, msgFbb));
+	if( !cxa_objectPool_contains(&msgPool, targetEntry) || (cxa_objectPool_getRefCount(&msgPool, targetEntry) == 0) ) return NULL;
 
-	// if we made it here, we couldn't find a match
-	return NULL;
+	return &targetEntry->msg;
 }
 
 
@@ -130,9 +114,9 @@ void cxa_rpc_messageFactory_incrementMessageRefCount(cxa_rpc_message_t *const ms
 	if( !isInit ) cxa_rpc_messageFactory_init();
 
 	cxa_rpc_messageFactory_msgEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
-	cxa_assert(targetEntry && (targetEntry->refCount < UINT8_MAX));
+	cxa_assert(targetEntry);
 
-	targetEntry->refCount++;
+	cxa_objectPool_retain(&msgPool, targetEntry);
 	cxa_logger_trace(&logger, "message %p referenced", &currBuffer->msg);
 }
 
@@ -144,9 +128,8 @@ void cxa_rpc_messageFactory_decrementMessageRefCount(cxa_rpc_message_t *const ms
 	cxa_rpc_messageFactory_msgEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
 	cxa_assert(targetEntry);
 
-	if( targetEntry->refCount > 0 )
+	if( cxa_objectPool_release(&msgPool, targetEntry) )
 	{
-		targetEntry->refCount--;
 		cxa_logger_trace(&logger, "message %p dereferenced", &targetEntry->msg);
 	}
 	else cxa_logger_warn(&logger, "mismatched decrement call for %p", &targetEntry->msg);
@@ -160,19 +143,15 @@ uint8_t cxa_rpc_messageFactory_getReferenceCountForMessage(cxa_rpc_message_t *co
 	cxa_rpc_messageFactory_msgEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
 	cxa_assert(targetEntry);
 
-	return targetEntry->refCount;
+	return cxa_objectPool_getRefCount(&msgPool, targetEntry);
 }
 
 
 // ******** local function implementations ********
 static cxa_rpc_messageFactory_msgEntry_t* getMsgEntryFromMessage(cxa_rpc_message_t *const msgIn)
 {
-	for( size_t i = 0; i < (sizeof(msgPool)/sizeof(*msgPool)); i++ )
-	{
-		cxa_rpc_messageFactory_msgEntry_t* currEntry = (cxa_rpc_messageFactory_msgEntry_t*)&msgPool[i];
-
-		if( &currEntry->msg == msgIn ) return currEntry;
-	}
+	// the message is embedded in its entry...work backwards to the entry
+	cxa_rpc_messageFactory_msgEntry_t* retVal = (cxa_rpc_messageFactory_msgEntry_t*)((uintptr_t)msgIn - offsetof(cxa_rpc_messageFactory_msgEntry_t, msg));
 
-	return NULL;
+	return cxa_objectPool_contains(&msgPool, retVal) ? retVal : NULL;
 }
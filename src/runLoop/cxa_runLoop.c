@@ -4,12 +4,21 @@
  *
  * @author Christopher Armenio
  */
+// ppoll (sub-millisecond tickless sleeps on linux) is only declared with _GNU_SOURCE
+#if (defined __linux__) && !(defined _GNU_SOURCE)
+	#define _GNU_SOURCE
+#endif
 #include "cxa_runLoop.h"
 
 
 // ******** includes ********
 #include <cxa_assert.h>
-#include <cxa_timeDiff.h>
+#include <cxa_objectPool.h>
+#include <cxa_timeBase.h>
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	#include <string.h>
+#endif
 
 // include for our target build system
 #ifdef __XC
@@ -22,12 +31,51 @@
     #include <esp_task_wdt.h>
 #endif
 
+#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+	#include <cxa_posix_workerPool.h>
+#endif
+
+#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	#include <cxa_mpmcQueue.h>
+	#if (CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES & (CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES - 1)) != 0
+		#error CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES is not a power of 2
+	#endif
+#endif
+
+#if (CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0) || (defined CXA_RUNLOOP_TICKLESS_ENABLE)
+	// thread contexts may be looked up (and created) from other threads
+	#define THREADCONTEXTS_SHARED
+	#include <stdatomic.h>
+	#include <cxa_criticalSection.h>
+#endif
+
+#if (defined CXA_RUNLOOP_TICKLESS_ENABLE) || (CXA_RUNLOOP_MAXNUM_FDSOURCES > 0)
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#ifdef __linux__
+		#include <sys/eventfd.h>
+	#endif
+#endif
+
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_TRACE
 #include <cxa_logger_implementation.h>
 #include <cxa_config.h>
 
 // ******** local macro definitions ********
+#define POLLFD_INDEX_WAKEUP				0
+#define POLLFD_INDEX_FIRSTSOURCE		1
+
+// one-shots drained from the inbox come from their own pool but are scheduled alongside our entries
+#define MAXNUM_SCHEDULED_ENTRIES		(CXA_RUNLOOP_MAXNUM_ENTRIES + CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES)
+
+#if CXA_RUNLOOP_CACHELINE_SIZE > 0
+	#define CACHELINE_ALIGNED			_Alignas(CXA_RUNLOOP_CACHELINE_SIZE)
+#else
+	#define CACHELINE_ALIGNED
+#endif
 
 
 // ******** local type definitions ********
@@ -43,35 +91,204 @@ typedef enum
 typedef enum
 {
 	TYPE_STANDARD,
-	TYPE_ONESHOT
+	TYPE_ONESHOT,
+	TYPE_INDEPENDENT
 }type_t;
 
 
-typedef struct
+typedef struct cxa_runLoop_entry cxa_runLoop_entry_t;
+
+
+struct cxa_runLoop_entry
 {
 	state_t state;
 	type_t type;
 
 	int threadId;
+	cxa_runLoop_priority_t priority;
 
 	uint32_t execPeriod_ms;
-	cxa_timeDiff_t td_exec;
+	uint64_t nextExecTime_ns;
 
 	cxa_runLoop_cb_t startupCb;
 	cxa_runLoop_cb_t updateCb;
 	void *userVar;
-}cxa_runLoop_entry_t;
+
+	cxa_runLoop_entry_t* nextUnstarted;
+
+	#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	cxa_runLoop_profile_t profile;
+	#endif
+};
+
+
+#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+typedef struct
+{
+	cxa_runLoop_cb_t updateCb;
+	void *userVar;
+	uint32_t delay_ms;
+	uint64_t execTime_ns;
+}inboxMsg_t;
+#endif
+
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+typedef struct
+{
+	cxa_runLoop_cb_fdReady_t cb;
+	void* userVar;
+}fdSource_t;
+#endif
+
+
+typedef struct
+{
+	cxa_runLoop_cb_t cb;
+	void* userVar;
+}endOfIterationCb_t;
+
+
+/**
+ * Scheduling state for a single thread. Untimed entries run every
+ * iteration, timed entries are kept in a min-heap ordered by their
+ * next execution time so we only ever look at the entries which are due.
+ * Each thread owns its entries so no thread ever touches another's.
+ */
+typedef struct
+{
+#ifdef THREADCONTEXTS_SHARED
+	// only set (with release) once the rest of the context is initialized
+	CACHELINE_ALIGNED atomic_bool isUsed;
+#else
+	CACHELINE_ALIGNED bool isUsed;
+#endif
+	int threadId;
+
+	cxa_runLoop_entry_t entries[CXA_RUNLOOP_MAXNUM_ENTRIES];
+	cxa_objectPool_t entryPool;
+	cxa_objectPool_slot_t entryPool_slots[CXA_RUNLOOP_MAXNUM_ENTRIES];
+
+	cxa_runLoop_entry_t* unstarted_head;
+	cxa_runLoop_entry_t* unstarted_tail;
+
+	// sorted by priority
+	cxa_runLoop_entry_t* untimedEntries[MAXNUM_SCHEDULED_ENTRIES];
+	size_t numUntimedEntries;
+
+	// timed entries due this iteration, sorted by priority then deadline
+	cxa_runLoop_entry_t* dueTimedEntries[MAXNUM_SCHEDULED_ENTRIES];
+	size_t numDueTimedEntries;
+
+	uint32_t iterationBudget_us;
+	bool wasLowPriorityDeferred;
+
+	// called at the end of each iteration (in order of registration)
+	endOfIterationCb_t endOfIterationCbs[CXA_RUNLOOP_MAXNUM_ENDOFITERATION_CBS];
+	size_t numEndOfIterationCbs;
+
+	// reset at the end of each iteration (may be NULL)
+	cxa_arena_t* iterationArena;
+
+	// sampled once at the start of each iteration
+	uint64_t iterationTime_ns;
+
+	cxa_runLoop_entry_t* timerHeap[MAXNUM_SCHEDULED_ENTRIES];
+	size_t timerHeapSize;
+
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	// posted to by any thread, drained only by the owning thread
+	cxa_mpmcQueue_t inbox;
+	inboxMsg_t inbox_buffer[CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES];
+	cxa_mpmcQueue_seq_t inbox_seqs[CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES];
+
+	// only touched by the owning thread
+	cxa_runLoop_entry_t inboxEntries[CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES];
+	cxa_objectPool_t inboxEntryPool;
+	cxa_objectPool_slot_t inboxEntryPool_slots[CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES];
+	#endif
+
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	int wakeupFd_read;
+	int wakeupFd_write;
+	#endif
+
+	#if (defined CXA_RUNLOOP_TICKLESS_ENABLE) || (CXA_RUNLOOP_MAXNUM_FDSOURCES > 0)
+	// wakeup descriptor first, followed by one slot per fd source
+	struct pollfd pollFds[POLLFD_INDEX_FIRSTSOURCE + CXA_RUNLOOP_MAXNUM_FDSOURCES];
+	#endif
+
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	fdSource_t fdSources[CXA_RUNLOOP_MAXNUM_FDSOURCES];
+	size_t numFdSourceSlots;
+	#endif
+
+	#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+	// started with the first independent entry
+	bool isWorkerPoolStarted;
+	cxa_posix_workerPool_t workerPool;
+
+	// timed independent entries which are running this iteration
+	cxa_runLoop_entry_t* inFlightTimedEntries[CXA_RUNLOOP_MAXNUM_ENTRIES];
+	size_t numInFlightTimedEntries;
+	#endif
+}threadContext_t;
 
 
 // ******** local function prototypes ********
 static void init(void);
-static cxa_runLoop_entry_t* reserveUnusedEntry(void);
+static cxa_runLoop_entry_t* reserveUnusedEntry(threadContext_t *const ctxIn);
+static void freeEntry(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn);
+static void addEntry(int threadIdIn, type_t typeIn, cxa_runLoop_priority_t priorityIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+static void queueUnstartedEntry(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn, type_t typeIn, cxa_runLoop_priority_t priorityIn,
+								uint32_t execPeriod_msIn, uint64_t nextExecTime_nsIn,
+								cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+
+static threadContext_t* getThreadContext(int threadIdIn);
+static inline bool threadContext_isUsed(threadContext_t *const ctxIn);
+static inline void threadContext_setUsed(threadContext_t *const ctxIn, bool isUsedIn);
+static void startUnstartedEntries(threadContext_t *const ctxIn);
+static void runUntimedEntries(threadContext_t *const ctxIn, cxa_runLoop_priority_t priorityIn);
+static void compactUntimedEntries(threadContext_t *const ctxIn);
+static void collectDueTimedEntries(threadContext_t *const ctxIn, uint64_t now_nsIn);
+static void runDueTimedEntries(threadContext_t *const ctxIn, cxa_runLoop_priority_t priorityIn, uint64_t now_nsIn);
+static void deferDueTimedEntries(threadContext_t *const ctxIn);
+static bool shouldDeferLowPriority(threadContext_t *const ctxIn, uint64_t iter_startTime_nsIn);
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+static void runReadyFdSources(threadContext_t *const ctxIn);
+#endif
+
+#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+static void inbox_init(threadContext_t *const ctxIn);
+static bool inbox_post(threadContext_t *const ctxIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+static bool inbox_isEmpty(threadContext_t *const ctxIn);
+static void inbox_drain(threadContext_t *const ctxIn);
+#endif
+
+static inline bool isTimeReached(uint64_t now_nsIn, uint64_t target_nsIn);
+static inline void callUpdate(cxa_runLoop_entry_t *const entryIn);
+#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+static void joinIndependentEntries(threadContext_t *const ctxIn, uint64_t now_nsIn);
+static void workerPoolCb_runEntry(void* userVarIn);
+#endif
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void profiler_record(cxa_runLoop_entry_t *const entryIn, uint64_t startTime_nsIn, uint32_t execTime_usIn);
+#endif
+
+#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+static void wakeup_open(threadContext_t *const ctxIn);
+static void wakeup_close(threadContext_t *const ctxIn);
+static void wakeup_signal(threadContext_t *const ctxIn);
+static void waitForNextDeadline(threadContext_t *const ctxIn);
+#endif
+static void timerHeap_push(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn);
+static cxa_runLoop_entry_t* timerHeap_pop(threadContext_t *const ctxIn);
 
 
 // ********  local variable declarations *********
 static bool isInit = false;
 
-static cxa_runLoop_entry_t entries[CXA_RUNLOOP_MAXNUM_ENTRIES];
+static threadContext_t threadContexts[CXA_RUNLOOP_MAXNUM_THREADS];
 
 static cxa_logger_t logger;
 
@@ -81,17 +298,7 @@ void cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runL
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
-	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
-
-	newEntry->threadId = threadIdIn;
-	newEntry->type = TYPE_STANDARD;
-	newEntry->execPeriod_ms=0;
-	newEntry->startupCb=startupCbIn;
-	newEntry->updateCb=updateCbIn;
-	newEntry->userVar=userVarIn;
-	cxa_timeDiff_init(&newEntry->td_exec);
-	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+	addEntry(threadIdIn, TYPE_STANDARD, CXA_RUNLOOP_PRIORITY_NORMAL, 0, startupCbIn, updateCbIn, userVarIn);
 }
 
 
@@ -99,17 +306,89 @@ void cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_run
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
-	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
+	addEntry(threadIdIn, TYPE_STANDARD, CXA_RUNLOOP_PRIORITY_NORMAL, execPeriod_msIn, startupCbIn, updateCbIn, userVarIn);
+}
+
+
+#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+void cxa_runLoop_addIndependentEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	if( !isInit ) init();
+
+	addEntry(threadIdIn, TYPE_INDEPENDENT, CXA_RUNLOOP_PRIORITY_NORMAL, 0, startupCbIn, updateCbIn, userVarIn);
+}
+
+
+void cxa_runLoop_addIndependentTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	if( !isInit ) init();
+
+	addEntry(threadIdIn, TYPE_INDEPENDENT, CXA_RUNLOOP_PRIORITY_NORMAL, execPeriod_msIn, startupCbIn, updateCbIn, userVarIn);
+}
+#endif
+
+
+void cxa_runLoop_addEntry_withPriority(int threadIdIn, cxa_runLoop_priority_t priorityIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	if( !isInit ) init();
+
+	addEntry(threadIdIn, TYPE_STANDARD, priorityIn, 0, startupCbIn, updateCbIn, userVarIn);
+}
+
+
+void cxa_runLoop_addTimedEntry_withPriority(int threadIdIn, cxa_runLoop_priority_t priorityIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	if( !isInit ) init();
+
+	addEntry(threadIdIn, TYPE_STANDARD, priorityIn, execPeriod_msIn, startupCbIn, updateCbIn, userVarIn);
+}
+
+
+uint64_t cxa_runLoop_getIterationTime_ns(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	return (ctx->iterationTime_ns != 0) ? ctx->iterationTime_ns : cxa_timeBase_getCount_ns();
+}
+
+
+void cxa_runLoop_setIterationBudget_us(int threadIdIn, uint32_t budget_usIn)
+{
+	if( !isInit ) init();
+
+	getThreadContext(threadIdIn)->iterationBudget_us = budget_usIn;
+}
+
+
+void cxa_runLoop_setIterationArena(int threadIdIn, cxa_arena_t *const arenaIn)
+{
+	if( !isInit ) init();
+
+	getThreadContext(threadIdIn)->iterationArena = arenaIn;
+}
 
-	newEntry->threadId = threadIdIn;
-	newEntry->type = TYPE_STANDARD;
-	newEntry->execPeriod_ms=execPeriod_msIn;
-	newEntry->startupCb=startupCbIn;
-	newEntry->updateCb=updateCbIn;
-	newEntry->userVar=userVarIn;
-	cxa_timeDiff_init(&newEntry->td_exec);
-	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+
+cxa_arena_t* cxa_runLoop_getIterationArena(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	return getThreadContext(threadIdIn)->iterationArena;
+}
+
+
+void cxa_runLoop_addEndOfIterationCb(int threadIdIn, cxa_runLoop_cb_t cbIn, void *const userVarIn)
+{
+	cxa_assert(cbIn);
+
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	cxa_assert_msg((ctx->numEndOfIterationCbs < CXA_RUNLOOP_MAXNUM_ENDOFITERATION_CBS), "increase CXA_RUNLOOP_MAXNUM_ENDOFITERATION_CBS");
+
+	ctx->endOfIterationCbs[ctx->numEndOfIterationCbs].cb = cbIn;
+	ctx->endOfIterationCbs[ctx->numEndOfIterationCbs].userVar = userVarIn;
+	ctx->numEndOfIterationCbs++;
 }
 
 
@@ -120,78 +399,171 @@ void cxa_runLoop_clearAllEntries(void)
 }
 
 
-void cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+bool cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
-	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	return inbox_post(getThreadContext(threadIdIn), 0, updateCbIn, userVarIn);
+	#else
+	addEntry(threadIdIn, TYPE_ONESHOT, CXA_RUNLOOP_PRIORITY_NORMAL, 0, NULL, updateCbIn, userVarIn);
+	return true;
+	#endif
+}
+
 
-	newEntry->threadId = threadIdIn;
-	newEntry->type = TYPE_ONESHOT;
-	newEntry->execPeriod_ms=0;
-	newEntry->startupCb=NULL;
-	newEntry->updateCb=updateCbIn;
-	newEntry->userVar=userVarIn;
-	cxa_timeDiff_init(&newEntry->td_exec);
-	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+bool cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	if( !isInit ) init();
+
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	return inbox_post(getThreadContext(threadIdIn), delay_msIn, updateCbIn, userVarIn);
+	#else
+	addEntry(threadIdIn, TYPE_ONESHOT, CXA_RUNLOOP_PRIORITY_NORMAL, delay_msIn, NULL, updateCbIn, userVarIn);
+	return true;
+	#endif
 }
 
 
-void cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+uint32_t cxa_runLoop_getTimeUntilNextDeadline_us(int threadIdIn)
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
-	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+
+	// anything that hasn't started yet (or is untimed) runs on the next iteration
+	if( (ctx->unstarted_head != NULL) || (ctx->numUntimedEntries > 0) ) return 0;
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	if( !inbox_isEmpty(ctx) ) return 0;
+	#endif
+	if( ctx->timerHeapSize == 0 ) return CXA_RUNLOOP_NO_DEADLINE;
+
+	uint64_t now_ns = cxa_timeBase_getCount_ns();
+	uint64_t nextExecTime_ns = ctx->timerHeap[0]->nextExecTime_ns;
+	if( isTimeReached(now_ns, nextExecTime_ns) ) return 0;
+
+	// round up so we don't wake just before it's due (and don't collide with CXA_RUNLOOP_NO_DEADLINE)
+	uint64_t timeUntil_us = ((nextExecTime_ns - now_ns) + 999) / 1000;
+	return (timeUntil_us < CXA_RUNLOOP_NO_DEADLINE) ? (uint32_t)timeUntil_us : (CXA_RUNLOOP_NO_DEADLINE - 1);
+}
+
 
-	newEntry->threadId = threadIdIn;
-	newEntry->type = TYPE_ONESHOT;
-	newEntry->execPeriod_ms=delay_msIn;
-	newEntry->startupCb=NULL;
-	newEntry->updateCb=updateCbIn;
-	newEntry->userVar=userVarIn;
-	cxa_timeDiff_init(&newEntry->td_exec);
-	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+uint64_t cxa_runLoop_getTimeUntilNextTimedEntry_ns(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	if( ctx->timerHeapSize == 0 ) return UINT64_MAX;
+
+	uint64_t now_ns = cxa_timeBase_getCount_ns();
+	uint64_t nextExecTime_ns = ctx->timerHeap[0]->nextExecTime_ns;
+	return isTimeReached(now_ns, nextExecTime_ns) ? 0 : (nextExecTime_ns - now_ns);
 }
 
 
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+void cxa_runLoop_addFdSource(int threadIdIn, int fdIn, int eventsIn, cxa_runLoop_cb_fdReady_t cbIn, void *const userVarIn)
+{
+	cxa_assert(fdIn >= 0);
+	cxa_assert(cbIn);
+
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+
+	// re-use a removed slot if possible
+	size_t slotIndex;
+	for( slotIndex = 0; slotIndex < ctx->numFdSourceSlots; slotIndex++ )
+	{
+		if( ctx->fdSources[slotIndex].cb == NULL ) break;
+	}
+	if( slotIndex == ctx->numFdSourceSlots )
+	{
+		cxa_assert_msg((slotIndex < CXA_RUNLOOP_MAXNUM_FDSOURCES), "increase CXA_RUNLOOP_MAXNUM_FDSOURCES");
+		ctx->numFdSourceSlots++;
+	}
+
+	ctx->fdSources[slotIndex].cb = cbIn;
+	ctx->fdSources[slotIndex].userVar = userVarIn;
+
+	struct pollfd* pfd = &ctx->pollFds[POLLFD_INDEX_FIRSTSOURCE + slotIndex];
+	pfd->events = ((eventsIn & CXA_RUNLOOP_FDEVENT_READABLE) ? POLLIN : 0) |
+				  ((eventsIn & CXA_RUNLOOP_FDEVENT_WRITABLE) ? POLLOUT : 0);
+	pfd->revents = 0;
+	pfd->fd = fdIn;
+
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	// the thread may be sleeping without this descriptor
+	wakeup_signal(ctx);
+	#endif
+}
+
+
+void cxa_runLoop_removeFdSource(int threadIdIn, int fdIn)
+{
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+
+	for( size_t i = 0; i < ctx->numFdSourceSlots; i++ )
+	{
+		struct pollfd* pfd = &ctx->pollFds[POLLFD_INDEX_FIRSTSOURCE + i];
+		if( (ctx->fdSources[i].cb == NULL) || (pfd->fd != fdIn) ) continue;
+
+		// negative descriptors are ignored by poll
+		ctx->fdSources[i].cb = NULL;
+		pfd->fd = -1;
+		pfd->revents = 0;
+	}
+}
+#endif
+
+
 uint32_t cxa_runLoop_iterate(int threadIdIn)
 {
 	if( !isInit ) init();
 
-	uint32_t iter_startTime_us = cxa_timeBase_getCount_us();
+	uint64_t iter_startTime_ns = cxa_timeBase_getCount_ns();
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	ctx->iterationTime_ns = iter_startTime_ns;
 
-	// iterate first and make sure all of our entries have been started
-	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	// pick up anything dispatched to us (possibly from other threads)
+	inbox_drain(ctx);
+	#endif
+
+	// make sure all of our entries have been started
+	startUnstartedEntries(ctx);
+
+	// now call our update functions (highest priority first)
+	collectDueTimedEntries(ctx, iter_startTime_ns);
+	for( int currPriority = CXA_RUNLOOP_PRIORITY_HIGH; currPriority <= CXA_RUNLOOP_PRIORITY_LOW; currPriority++ )
 	{
-		if( (entries[i].threadId == threadIdIn) &&
-			(entries[i].state == STATE_RESERVED_CONFIGURED_UNSTARTED) )
+		if( (currPriority == CXA_RUNLOOP_PRIORITY_LOW) && shouldDeferLowPriority(ctx, iter_startTime_ns) )
 		{
-			if( entries[i].startupCb != NULL ) entries[i].startupCb(entries[i].userVar);
-			entries[i].state = STATE_RESERVED_CONFIGURED_STARTED;
+			deferDueTimedEntries(ctx);
+			break;
 		}
+
+		runUntimedEntries(ctx, (cxa_runLoop_priority_t)currPriority);
+		runDueTimedEntries(ctx, (cxa_runLoop_priority_t)currPriority, iter_startTime_ns);
 	}
+	compactUntimedEntries(ctx);
+	#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+	joinIndependentEntries(ctx, iter_startTime_ns);
+	#endif
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	runReadyFdSources(ctx);
+	#endif
 
-	// now iterate again and call our update functions
-	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	for( size_t i = 0; i < ctx->numEndOfIterationCbs; i++ )
 	{
-		if( (entries[i].threadId == threadIdIn) &&
-			(entries[i].state == STATE_RESERVED_CONFIGURED_STARTED) )
-		{
-			// we know this is valid callback for this thread...
-			// if it's timed, make sure we're calling it at the right pace
-			if( (entries[i].execPeriod_ms == 0) ||
-				 cxa_timeDiff_isElapsed_recurring_ms(&entries[i].td_exec, entries[i].execPeriod_ms) )
-			{
-				entries[i].updateCb(entries[i].userVar);
-
-				// free this entry if it's a one-shot
-				if( entries[i].type == TYPE_ONESHOT ) entries[i].state = STATE_UNUSED;
-			}
-		}
+		ctx->endOfIterationCbs[i].cb(ctx->endOfIterationCbs[i].userVar);
 	}
 
+	// all transient allocations for this iteration are now dead
+	if( ctx->iterationArena != NULL ) cxa_arena_reset(ctx->iterationArena);
+
 #ifdef ESP32
     esp_task_wdt_feed();        // esp32 only
 #endif
@@ -200,7 +572,7 @@ uint32_t cxa_runLoop_iterate(int threadIdIn)
 	taskYIELD();
 #endif
 
-	return cxa_timeBase_getCount_us() - iter_startTime_us;
+	return (uint32_t)((cxa_timeBase_getCount_ns() - iter_startTime_ns) / 1000);
 }
 
 
@@ -208,22 +580,124 @@ void cxa_runLoop_execute(int threadIdIn)
 {
 	if( !isInit ) init();
 
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	#endif
+
 	// start the iterations
 	while(1)
 	{
 		cxa_runLoop_iterate(threadIdIn);
+
+		#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+		// nothing left to do this pass...sleep until there is
+		waitForNextDeadline(ctx);
+		#endif
 	}
 }
 
 
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+bool cxa_runLoop_profiler_getProfile(int threadIdIn, size_t entryIndexIn, cxa_runLoop_profile_t *const profileOut)
+{
+	cxa_assert(profileOut);
+
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	if( entryIndexIn >= (sizeof(ctx->entries)/sizeof(*ctx->entries)) ) return false;
+
+	cxa_runLoop_entry_t* entry = &ctx->entries[entryIndexIn];
+	if( entry->state != STATE_RESERVED_CONFIGURED_STARTED ) return false;
+
+	*profileOut = entry->profile;
+	profileOut->updateCb = entry->updateCb;
+	profileOut->userVar = entry->userVar;
+	profileOut->execPeriod_ms = entry->execPeriod_ms;
+
+	return true;
+}
+
+
+void cxa_runLoop_profiler_reset(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+	for( size_t i = 0; i < sizeof(ctx->entries)/sizeof(*ctx->entries); i++ )
+	{
+		memset(&ctx->entries[i].profile, 0, sizeof(ctx->entries[i].profile));
+	}
+}
+
+
+void cxa_runLoop_profiler_writeReport(cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	if( !isInit ) init();
+
+	for( size_t i = 0; i < sizeof(threadContexts)/sizeof(*threadContexts); i++ )
+	{
+		threadContext_t* currCtx = &threadContexts[i];
+		if( !threadContext_isUsed(currCtx) ) continue;
+
+		cxa_ioStream_writeFormattedLine(ioStreamIn, "thread %d:", currCtx->threadId);
+		for( size_t j = 0; j < sizeof(currCtx->entries)/sizeof(*currCtx->entries); j++ )
+		{
+			cxa_runLoop_profile_t prof;
+			if( !cxa_runLoop_profiler_getProfile(currCtx->threadId, j, &prof) ) continue;
+
+			// (written in pieces to stay within the formatting buffer)
+			cxa_ioStream_writeFormattedString(ioStreamIn, "  [%d] %p", (int)j, (void*)prof.updateCb);
+			cxa_ioStream_writeFormattedLine(ioStreamIn, " %lums", (unsigned long)prof.execPeriod_ms);
+			cxa_ioStream_writeFormattedString(ioStreamIn, "    calls:%lu", (unsigned long)prof.numCalls);
+			cxa_ioStream_writeFormattedString(ioStreamIn, " avg:%luus",
+											  (unsigned long)((prof.numCalls > 0) ? (prof.totalExecTime_us / prof.numCalls) : 0));
+			cxa_ioStream_writeFormattedLine(ioStreamIn, " max:%luus", (unsigned long)prof.maxExecTime_us);
+			if( prof.execPeriod_ms != 0 )
+			{
+				cxa_ioStream_writeFormattedString(ioStreamIn, "    late avg:%luus",
+												  (unsigned long)((prof.numCalls > 0) ? (prof.totalLateness_us / prof.numCalls) : 0));
+				cxa_ioStream_writeFormattedString(ioStreamIn, " max:%luus", (unsigned long)prof.maxLateness_us);
+				cxa_ioStream_writeFormattedLine(ioStreamIn, " overruns:%lu", (unsigned long)prof.numOverruns);
+			}
+			cxa_ioStream_writeString(ioStreamIn, "    hist:");
+			for( size_t k = 0; k < CXA_RUNLOOP_PROFILER_NUM_BUCKETS; k++ )
+			{
+				cxa_ioStream_writeFormattedString(ioStreamIn, " %lu", (unsigned long)prof.histogram[k]);
+			}
+			cxa_ioStream_writeLine(ioStreamIn, "");
+		}
+	}
+}
+#endif
+
+
+#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+void cxa_runLoop_wakeup(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	wakeup_signal(getThreadContext(threadIdIn));
+}
+#endif
+
+
 // ******** local function implementations ********
 static void init(void)
 {
 	if( isInit ) return;
 
-	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	for( size_t i = 0; i < sizeof(threadContexts)/sizeof(*threadContexts); i++ )
 	{
-		entries[i].state = STATE_UNUSED;
+		#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+		if( threadContext_isUsed(&threadContexts[i]) ) wakeup_close(&threadContexts[i]);
+		#endif
+		#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+		if( threadContext_isUsed(&threadContexts[i]) && threadContexts[i].isWorkerPoolStarted ) cxa_posix_workerPool_deinit(&threadContexts[i].workerPool);
+		#endif
+		threadContext_setUsed(&threadContexts[i], false);
 	}
 	cxa_logger_init(&logger, "runLoop");
 
@@ -231,16 +705,591 @@ static void init(void)
 }
 
 
-static cxa_runLoop_entry_t* reserveUnusedEntry(void)
+static cxa_runLoop_entry_t* reserveUnusedEntry(threadContext_t *const ctxIn)
+{
+	cxa_runLoop_entry_t* retVal = (cxa_runLoop_entry_t*)cxa_objectPool_reserve(&ctxIn->entryPool);
+	if( retVal != NULL ) retVal->state = STATE_RESERVED_CONFIGURING;
+
+	return retVal;
+}
+
+
+static void freeEntry(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn)
+{
+	entryIn->state = STATE_UNUSED;
+
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	if( cxa_objectPool_contains(&ctxIn->inboxEntryPool, entryIn) )
+	{
+		cxa_objectPool_release(&ctxIn->inboxEntryPool, entryIn);
+		return;
+	}
+	#endif
+	cxa_objectPool_release(&ctxIn->entryPool, entryIn);
+}
+
+
+static void addEntry(int threadIdIn, type_t typeIn, cxa_runLoop_priority_t priorityIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	threadContext_t* ctx = getThreadContext(threadIdIn);
+
+	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry(ctx);
+	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
+
+	#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+	if( (typeIn == TYPE_INDEPENDENT) && !ctx->isWorkerPoolStarted )
+	{
+		cxa_posix_workerPool_init(&ctx->workerPool, CXA_RUNLOOP_WORKERPOOL_NUM_WORKERS);
+		ctx->isWorkerPoolStarted = true;
+	}
+	#endif
+
+	queueUnstartedEntry(ctx, newEntry, typeIn, priorityIn,
+						execPeriod_msIn, cxa_timeBase_getCount_ns() + ((uint64_t)execPeriod_msIn * 1000000),
+						startupCbIn, updateCbIn, userVarIn);
+
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	// the thread may be sleeping with a later deadline
+	wakeup_signal(ctx);
+	#endif
+}
+
+
+static void queueUnstartedEntry(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn, type_t typeIn, cxa_runLoop_priority_t priorityIn,
+								uint32_t execPeriod_msIn, uint64_t nextExecTime_nsIn,
+								cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	entryIn->threadId = ctxIn->threadId;
+	entryIn->type = typeIn;
+	entryIn->priority = priorityIn;
+	entryIn->execPeriod_ms = execPeriod_msIn;
+	entryIn->nextExecTime_ns = nextExecTime_nsIn;
+	entryIn->startupCb = startupCbIn;
+	entryIn->updateCb = updateCbIn;
+	entryIn->userVar = userVarIn;
+
+	// queue it to be started on the next iteration of its thread
+	entryIn->nextUnstarted = NULL;
+	if( ctxIn->unstarted_tail != NULL ) ctxIn->unstarted_tail->nextUnstarted = entryIn;
+	else ctxIn->unstarted_head = entryIn;
+	ctxIn->unstarted_tail = entryIn;
+
+	#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	memset(&entryIn->profile, 0, sizeof(entryIn->profile));
+	#endif
+
+	entryIn->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+}
+
+
+static threadContext_t* getThreadContext(int threadIdIn)
+{
+	for( size_t i = 0; i < sizeof(threadContexts)/sizeof(*threadContexts); i++ )
+	{
+		if( threadContext_isUsed(&threadContexts[i]) && (threadContexts[i].threadId == threadIdIn) ) return &threadContexts[i];
+	}
+
+	#ifdef THREADCONTEXTS_SHARED
+	// another thread may be creating this context as well...look again while locked
+	cxa_criticalSection_enter();
+	for( size_t i = 0; i < sizeof(threadContexts)/sizeof(*threadContexts); i++ )
+	{
+		if( threadContext_isUsed(&threadContexts[i]) && (threadContexts[i].threadId == threadIdIn) )
+		{
+			cxa_criticalSection_exit();
+			return &threadContexts[i];
+		}
+	}
+	#endif
+
+	// first time we've seen this thread...setup a new context for it
+	threadContext_t* unusedCtx = NULL;
+	for( size_t i = 0; i < sizeof(threadContexts)/sizeof(*threadContexts); i++ )
+	{
+		if( !threadContext_isUsed(&threadContexts[i]) )
+		{
+			unusedCtx = &threadContexts[i];
+			break;
+		}
+	}
+	cxa_assert_msg(unusedCtx, "increase CXA_RUNLOOP_MAXNUM_THREADS (or define CXA_RUNLOOP_MULTITHREAD_ENABLE)");
+
+	unusedCtx->threadId = threadIdIn;
+	for( size_t i = 0; i < sizeof(unusedCtx->entries)/sizeof(*unusedCtx->entries); i++ )
+	{
+		unusedCtx->entries[i].state = STATE_UNUSED;
+	}
+	cxa_objectPool_initStd(&unusedCtx->entryPool, unusedCtx->entries, unusedCtx->entryPool_slots);
+	unusedCtx->unstarted_head = NULL;
+	unusedCtx->unstarted_tail = NULL;
+	unusedCtx->numUntimedEntries = 0;
+	unusedCtx->numDueTimedEntries = 0;
+	unusedCtx->iterationBudget_us = 0;
+	unusedCtx->numEndOfIterationCbs = 0;
+	unusedCtx->iterationArena = NULL;
+	unusedCtx->iterationTime_ns = 0;
+	unusedCtx->wasLowPriorityDeferred = false;
+	unusedCtx->timerHeapSize = 0;
+	#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+	inbox_init(unusedCtx);
+	#endif
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	wakeup_open(unusedCtx);
+	unusedCtx->pollFds[POLLFD_INDEX_WAKEUP].fd = unusedCtx->wakeupFd_read;
+	unusedCtx->pollFds[POLLFD_INDEX_WAKEUP].events = POLLIN;
+	#endif
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	unusedCtx->numFdSourceSlots = 0;
+	#endif
+	#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+	unusedCtx->isWorkerPoolStarted = false;
+	unusedCtx->numInFlightTimedEntries = 0;
+	#endif
+	threadContext_setUsed(unusedCtx, true);
+
+	#ifdef THREADCONTEXTS_SHARED
+	cxa_criticalSection_exit();
+	#endif
+
+	return unusedCtx;
+}
+
+
+static inline bool threadContext_isUsed(threadContext_t *const ctxIn)
+{
+#ifdef THREADCONTEXTS_SHARED
+	return atomic_load_explicit(&ctxIn->isUsed, memory_order_acquire);
+#else
+	return ctxIn->isUsed;
+#endif
+}
+
+
+static inline void threadContext_setUsed(threadContext_t *const ctxIn, bool isUsedIn)
+{
+#ifdef THREADCONTEXTS_SHARED
+	atomic_store_explicit(&ctxIn->isUsed, isUsedIn, memory_order_release);
+#else
+	ctxIn->isUsed = isUsedIn;
+#endif
+}
+
+
+static void startUnstartedEntries(threadContext_t *const ctxIn)
+{
+	// detach the current list so entries added by startup callbacks wait for the next iteration
+	cxa_runLoop_entry_t* currEntry = ctxIn->unstarted_head;
+	ctxIn->unstarted_head = NULL;
+	ctxIn->unstarted_tail = NULL;
+
+	while( currEntry != NULL )
+	{
+		cxa_runLoop_entry_t* nextEntry = currEntry->nextUnstarted;
+
+		if( currEntry->startupCb != NULL ) currEntry->startupCb(currEntry->userVar);
+		currEntry->state = STATE_RESERVED_CONFIGURED_STARTED;
+
+		if( currEntry->execPeriod_ms == 0 )
+		{
+			// after any entries of the same (or higher) priority
+			cxa_assert_msg((ctxIn->numUntimedEntries < (sizeof(ctxIn->untimedEntries)/sizeof(*ctxIn->untimedEntries))), "too many untimed entries");
+			size_t insertIndex = ctxIn->numUntimedEntries;
+			while( (insertIndex > 0) && (ctxIn->untimedEntries[insertIndex-1]->priority > currEntry->priority) )
+			{
+				ctxIn->untimedEntries[insertIndex] = ctxIn->untimedEntries[insertIndex-1];
+				insertIndex--;
+			}
+			ctxIn->untimedEntries[insertIndex] = currEntry;
+			ctxIn->numUntimedEntries++;
+		}
+		else timerHeap_push(ctxIn, currEntry);
+
+		currEntry = nextEntry;
+	}
+}
+
+
+static void runUntimedEntries(threadContext_t *const ctxIn, cxa_runLoop_priority_t priorityIn)
+{
+	// entries added during this pass are unstarted so they won't touch this list
+	for( size_t i = 0; i < ctxIn->numUntimedEntries; i++ )
+	{
+		cxa_runLoop_entry_t* currEntry = ctxIn->untimedEntries[i];
+		if( (currEntry == NULL) || (currEntry->priority != priorityIn) ) continue;
+
+		#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+		if( currEntry->type == TYPE_INDEPENDENT ) cxa_posix_workerPool_submit(&ctxIn->workerPool, workerPoolCb_runEntry, currEntry);
+		else callUpdate(currEntry);
+		#else
+		callUpdate(currEntry);
+		#endif
+
+		// free this entry if it's a one-shot (removed from the list in compactUntimedEntries)
+		if( currEntry->type == TYPE_ONESHOT )
+		{
+			freeEntry(ctxIn, currEntry);
+			ctxIn->untimedEntries[i] = NULL;
+		}
+	}
+}
+
+
+static void compactUntimedEntries(threadContext_t *const ctxIn)
+{
+	size_t numRetainedEntries = 0;
+	for( size_t i = 0; i < ctxIn->numUntimedEntries; i++ )
+	{
+		if( ctxIn->untimedEntries[i] != NULL ) ctxIn->untimedEntries[numRetainedEntries++] = ctxIn->untimedEntries[i];
+	}
+	ctxIn->numUntimedEntries = numRetainedEntries;
+}
+
+
+static void collectDueTimedEntries(threadContext_t *const ctxIn, uint64_t now_nsIn)
+{
+	// the heap gives them to us most-overdue first...keep that order within each priority
+	ctxIn->numDueTimedEntries = 0;
+	while( (ctxIn->timerHeapSize > 0) && isTimeReached(now_nsIn, ctxIn->timerHeap[0]->nextExecTime_ns) )
+	{
+		cxa_runLoop_entry_t* currEntry = timerHeap_pop(ctxIn);
+
+		cxa_assert_msg((ctxIn->numDueTimedEntries < (sizeof(ctxIn->dueTimedEntries)/sizeof(*ctxIn->dueTimedEntries))), "too many due timed entries");
+		size_t insertIndex = ctxIn->numDueTimedEntries;
+		while( (insertIndex > 0) && (ctxIn->dueTimedEntries[insertIndex-1]->priority > currEntry->priority) )
+		{
+			ctxIn->dueTimedEntries[insertIndex] = ctxIn->dueTimedEntries[insertIndex-1];
+			insertIndex--;
+		}
+		ctxIn->dueTimedEntries[insertIndex] = currEntry;
+		ctxIn->numDueTimedEntries++;
+	}
+}
+
+
+static void runDueTimedEntries(threadContext_t *const ctxIn, cxa_runLoop_priority_t priorityIn, uint64_t now_nsIn)
+{
+	for( size_t i = 0; i < ctxIn->numDueTimedEntries; i++ )
+	{
+		cxa_runLoop_entry_t* currEntry = ctxIn->dueTimedEntries[i];
+		if( currEntry->priority != priorityIn ) continue;
+
+		#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+		// rescheduled once it's finished (see joinIndependentEntries)
+		if( currEntry->type == TYPE_INDEPENDENT )
+		{
+			cxa_posix_workerPool_submit(&ctxIn->workerPool, workerPoolCb_runEntry, currEntry);
+			cxa_assert_msg((ctxIn->numInFlightTimedEntries < (sizeof(ctxIn->inFlightTimedEntries)/sizeof(*ctxIn->inFlightTimedEntries))), "too many in-flight entries");
+			ctxIn->inFlightTimedEntries[ctxIn->numInFlightTimedEntries++] = currEntry;
+			continue;
+		}
+		#endif
+
+		callUpdate(currEntry);
+
+		// free this entry if it's a one-shot, otherwise reschedule it
+		if( currEntry->type == TYPE_ONESHOT )
+		{
+			freeEntry(ctxIn, currEntry);
+			continue;
+		}
+		currEntry->nextExecTime_ns = now_nsIn + ((uint64_t)currEntry->execPeriod_ms * 1000000);
+		timerHeap_push(ctxIn, currEntry);
+	}
+}
+
+
+static void deferDueTimedEntries(threadContext_t *const ctxIn)
+{
+	// still overdue, so they'll be first in line next iteration
+	for( size_t i = 0; i < ctxIn->numDueTimedEntries; i++ )
+	{
+		if( ctxIn->dueTimedEntries[i]->priority == CXA_RUNLOOP_PRIORITY_LOW ) timerHeap_push(ctxIn, ctxIn->dueTimedEntries[i]);
+	}
+	ctxIn->numDueTimedEntries = 0;
+}
+
+
+static bool shouldDeferLowPriority(threadContext_t *const ctxIn, uint64_t iter_startTime_nsIn)
+{
+	if( ctxIn->iterationBudget_us == 0 ) return false;
+
+	// don't starve them...they always run the iteration after being deferred
+	if( ctxIn->wasLowPriorityDeferred )
+	{
+		ctxIn->wasLowPriorityDeferred = false;
+		return false;
+	}
+
+	ctxIn->wasLowPriorityDeferred = ((cxa_timeBase_getCount_ns() - iter_startTime_nsIn) > ((uint64_t)ctxIn->iterationBudget_us * 1000));
+	return ctxIn->wasLowPriorityDeferred;
+}
+
+
+#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+static void runReadyFdSources(threadContext_t *const ctxIn)
+{
+	if( ctxIn->numFdSourceSlots == 0 ) return;
+
+	// one non-blocking syscall covers every descriptor of this thread
+	int retVal_poll = poll(&ctxIn->pollFds[POLLFD_INDEX_FIRSTSOURCE], ctxIn->numFdSourceSlots, 0);
+	if( retVal_poll <= 0 ) return;
+
+	for( size_t i = 0; i < ctxIn->numFdSourceSlots; i++ )
+	{
+		struct pollfd* pfd = &ctxIn->pollFds[POLLFD_INDEX_FIRSTSOURCE + i];
+		fdSource_t* currSource = &ctxIn->fdSources[i];
+		if( (pfd->revents == 0) || (currSource->cb == NULL) ) continue;
+
+		int events = ((pfd->revents & POLLIN) ? CXA_RUNLOOP_FDEVENT_READABLE : 0) |
+					 ((pfd->revents & POLLOUT) ? CXA_RUNLOOP_FDEVENT_WRITABLE : 0) |
+					 ((pfd->revents & (POLLERR | POLLHUP | POLLNVAL)) ? CXA_RUNLOOP_FDEVENT_ERROR : 0);
+		pfd->revents = 0;
+
+		currSource->cb(pfd->fd, events, currSource->userVar);
+	}
+}
+#endif
+
+
+#if CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES > 0
+static void inbox_init(threadContext_t *const ctxIn)
+{
+	cxa_mpmcQueue_initStd(&ctxIn->inbox, ctxIn->inbox_buffer, ctxIn->inbox_seqs);
+
+	for( size_t i = 0; i < CXA_RUNLOOP_MAXNUM_INBOX_ENTRIES; i++ )
+	{
+		ctxIn->inboxEntries[i].state = STATE_UNUSED;
+	}
+	cxa_objectPool_initStd(&ctxIn->inboxEntryPool, ctxIn->inboxEntries, ctxIn->inboxEntryPool_slots);
+}
+
+
+static bool inbox_post(threadContext_t *const ctxIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+{
+	inboxMsg_t msg = {.updateCb=updateCbIn, .userVar=userVarIn, .delay_ms=delay_msIn,
+					  .execTime_ns=cxa_timeBase_getCount_ns() + ((uint64_t)delay_msIn * 1000000)};
+	if( !cxa_mpmcQueue_queue(&ctxIn->inbox, &msg) ) return false;
+
+	#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+	wakeup_signal(ctxIn);
+	#endif
+
+	return true;
+}
+
+
+static bool inbox_isEmpty(threadContext_t *const ctxIn)
+{
+	// messages we have no free entries for can't be drained until one of ours runs
+	return (cxa_objectPool_getNumFree_elems(&ctxIn->inboxEntryPool) == 0) || cxa_mpmcQueue_isEmpty(&ctxIn->inbox);
+}
+
+
+static void inbox_drain(threadContext_t *const ctxIn)
+{
+	// anything we can't find a home for stays queued (and posters see a full inbox)
+	while( cxa_objectPool_getNumFree_elems(&ctxIn->inboxEntryPool) > 0 )
+	{
+		inboxMsg_t msg;
+		if( !cxa_mpmcQueue_dequeue(&ctxIn->inbox, &msg) ) break;
+
+		cxa_runLoop_entry_t* newEntry = (cxa_runLoop_entry_t*)cxa_objectPool_reserve(&ctxIn->inboxEntryPool);
+		cxa_assert(newEntry);
+
+		queueUnstartedEntry(ctxIn, newEntry, TYPE_ONESHOT, CXA_RUNLOOP_PRIORITY_NORMAL,
+							msg.delay_ms, msg.execTime_ns,
+							NULL, msg.updateCb, msg.userVar);
+	}
+}
+#endif
+
+
+static inline void callUpdate(cxa_runLoop_entry_t *const entryIn)
+{
+	#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	uint64_t startTime_ns = cxa_timeBase_getCount_ns();
+	entryIn->updateCb(entryIn->userVar);
+	profiler_record(entryIn, startTime_ns, (uint32_t)((cxa_timeBase_getCount_ns() - startTime_ns) / 1000));
+	#else
+	entryIn->updateCb(entryIn->userVar);
+	#endif
+}
+
+
+#ifdef CXA_RUNLOOP_WORKERPOOL_ENABLE
+static void joinIndependentEntries(threadContext_t *const ctxIn, uint64_t now_nsIn)
+{
+	if( !ctxIn->isWorkerPoolStarted ) return;
+
+	cxa_posix_workerPool_waitForIdle(&ctxIn->workerPool);
+
+	for( size_t i = 0; i < ctxIn->numInFlightTimedEntries; i++ )
+	{
+		cxa_runLoop_entry_t* currEntry = ctxIn->inFlightTimedEntries[i];
+
+		currEntry->nextExecTime_ns = now_nsIn + ((uint64_t)currEntry->execPeriod_ms * 1000000);
+		timerHeap_push(ctxIn, currEntry);
+	}
+	ctxIn->numInFlightTimedEntries = 0;
+}
+
+
+static void workerPoolCb_runEntry(void* userVarIn)
 {
-	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	callUpdate((cxa_runLoop_entry_t*)userVarIn);
+}
+#endif
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void profiler_record(cxa_runLoop_entry_t *const entryIn, uint64_t startTime_nsIn, uint32_t execTime_usIn)
+{
+	cxa_runLoop_profile_t* prof = &entryIn->profile;
+
+	prof->numCalls++;
+	prof->totalExecTime_us += execTime_usIn;
+	if( execTime_usIn > prof->maxExecTime_us ) prof->maxExecTime_us = execTime_usIn;
+
+	// bucket is the number of significant bits
+	size_t bucket = 0;
+	for( uint32_t remaining = execTime_usIn; (remaining != 0) && (bucket < (CXA_RUNLOOP_PROFILER_NUM_BUCKETS-1)); remaining >>= 1 ) bucket++;
+	prof->histogram[bucket]++;
+
+	if( entryIn->execPeriod_ms == 0 ) return;
+
+	// nextExecTime_ns is still the time we were scheduled for
+	if( isTimeReached(startTime_nsIn, entryIn->nextExecTime_ns) )
 	{
-		if( entries[i].state == STATE_UNUSED )
+		uint32_t lateness_us = (uint32_t)((startTime_nsIn - entryIn->nextExecTime_ns) / 1000);
+		prof->totalLateness_us += lateness_us;
+		if( lateness_us > prof->maxLateness_us ) prof->maxLateness_us = lateness_us;
+	}
+	if( execTime_usIn > ((uint64_t)entryIn->execPeriod_ms * 1000) ) prof->numOverruns++;
+}
+#endif
+
+
+static inline bool isTimeReached(uint64_t now_nsIn, uint64_t target_nsIn)
+{
+	// 64-bit nanoseconds won't roll over
+	return (now_nsIn >= target_nsIn);
+}
+
+
+static void timerHeap_push(threadContext_t *const ctxIn, cxa_runLoop_entry_t *const entryIn)
+{
+	cxa_assert_msg((ctxIn->timerHeapSize < (sizeof(ctxIn->timerHeap)/sizeof(*ctxIn->timerHeap))), "too many timed entries");
+
+	// sift up from the bottom
+	size_t currIndex = ctxIn->timerHeapSize++;
+	while( currIndex > 0 )
+	{
+		size_t parentIndex = (currIndex - 1) / 2;
+		cxa_runLoop_entry_t* parentEntry = ctxIn->timerHeap[parentIndex];
+		if( isTimeReached(entryIn->nextExecTime_ns, parentEntry->nextExecTime_ns) ) break;
+
+		ctxIn->timerHeap[currIndex] = parentEntry;
+		currIndex = parentIndex;
+	}
+	ctxIn->timerHeap[currIndex] = entryIn;
+}
+
+
+static cxa_runLoop_entry_t* timerHeap_pop(threadContext_t *const ctxIn)
+{
+	cxa_assert(ctxIn->timerHeapSize > 0);
+
+	cxa_runLoop_entry_t* retVal = ctxIn->timerHeap[0];
+	cxa_runLoop_entry_t* lastEntry = ctxIn->timerHeap[--ctxIn->timerHeapSize];
+
+	// sift the last entry down from the top
+	size_t currIndex = 0;
+	while( true )
+	{
+		size_t childIndex = (2 * currIndex) + 1;
+		if( childIndex >= ctxIn->timerHeapSize ) break;
+
+		// pick the earlier of our two children
+		if( ((childIndex + 1) < ctxIn->timerHeapSize) &&
+			!isTimeReached(ctxIn->timerHeap[childIndex+1]->nextExecTime_ns, ctxIn->timerHeap[childIndex]->nextExecTime_ns) )
 		{
-			entries[i].state = STATE_RESERVED_CONFIGURING;
-			return &entries[i];
+			childIndex++;
 		}
+		if( isTimeReached(ctxIn->timerHeap[childIndex]->nextExecTime_ns, lastEntry->nextExecTime_ns) ) break;
+
+		ctxIn->timerHeap[currIndex] = ctxIn->timerHeap[childIndex];
+		currIndex = childIndex;
 	}
+	ctxIn->timerHeap[currIndex] = lastEntry;
+
+	return retVal;
+}
+
+
+#ifdef CXA_RUNLOOP_TICKLESS_ENABLE
+static void wakeup_open(threadContext_t *const ctxIn)
+{
+#ifdef __linux__
+	ctxIn->wakeupFd_read = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cxa_assert_msg(ctxIn->wakeupFd_read >= 0, "eventfd failed");
+	ctxIn->wakeupFd_write = ctxIn->wakeupFd_read;
+#else
+	int fds[2];
+	cxa_assert_msg(pipe(fds) == 0, "pipe failed");
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+	ctxIn->wakeupFd_read = fds[0];
+	ctxIn->wakeupFd_write = fds[1];
+#endif
+}
+
+
+static void wakeup_close(threadContext_t *const ctxIn)
+{
+	close(ctxIn->wakeupFd_read);
+	if( ctxIn->wakeupFd_write != ctxIn->wakeupFd_read ) close(ctxIn->wakeupFd_write);
+}
 
-	return NULL;
+
+static void wakeup_signal(threadContext_t *const ctxIn)
+{
+	// a full pipe / saturated eventfd already means a wakeup is pending
+#ifdef __linux__
+	uint64_t val = 1;
+	(void)!write(ctxIn->wakeupFd_write, &val, sizeof(val));
+#else
+	uint8_t val = 1;
+	(void)!write(ctxIn->wakeupFd_write, &val, sizeof(val));
+#endif
+}
+
+
+static void waitForNextDeadline(threadContext_t *const ctxIn)
+{
+	uint32_t timeout_us = cxa_runLoop_getTimeUntilNextDeadline_us(ctxIn->threadId);
+	if( timeout_us == 0 ) return;
+
+	// wait on our wakeup descriptor and any fd sources
+	nfds_t numPollFds = POLLFD_INDEX_FIRSTSOURCE;
+	#if CXA_RUNLOOP_MAXNUM_FDSOURCES > 0
+	numPollFds += ctxIn->numFdSourceSlots;
+	#endif
+
+	int retVal_poll;
+#ifdef __linux__
+	struct timespec timeout = {.tv_sec=timeout_us / 1000000, .tv_nsec=(timeout_us % 1000000) * 1000};
+	retVal_poll = ppoll(ctxIn->pollFds, numPollFds, (timeout_us == CXA_RUNLOOP_NO_DEADLINE) ? NULL : &timeout, NULL);
+#else
+	// round up so we never wake before the deadline
+	retVal_poll = poll(ctxIn->pollFds, numPollFds, (timeout_us == CXA_RUNLOOP_NO_DEADLINE) ? -1 : (int)((timeout_us + 999) / 1000));
+#endif
+	if( (retVal_poll < 0) && (errno != EINTR) ) cxa_logger_warn(&logger, "poll failed: %d", errno);
+
+	// drain any pending wakeups (ready fd sources are serviced by the next iteration)
+	if( (retVal_poll > 0) && (ctxIn->pollFds[POLLFD_INDEX_WAKEUP].revents & POLLIN) )
+	{
+		uint8_t drainBuffer[16];
+		while( read(ctxIn->wakeupFd_read, drainBuffer, sizeof(drainBuffer)) > 0 );
+	}
 }
+#endif
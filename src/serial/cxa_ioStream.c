@@ -21,14 +21,14 @@
 
 
 // ******** local macro definitions ********
-#ifndef CXA_IOSTREAM_FORMATTED_BUFFERLEN_BYTES
-	#define CXA_IOSTREAM_FORMATTED_BUFFERLEN_BYTES				24
-#endif
-
 #ifndef CXA_IOSTREAM_MAXNUM_CLEARED_BYTES
 	#define CXA_IOSTREAM_MAXNUM_CLEARED_BYTES					4096
 #endif
 
+#ifndef CXA_IOSTREAM_CLEAR_CHUNKSIZE_BYTES
+	#define CXA_IOSTREAM_CLEAR_CHUNKSIZE_BYTES					32
+#endif
+
 
 // ******** local type definitions ********
 
@@ -55,17 +55,39 @@ void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByt
 
 	// save our references
 	ioStreamIn->readCb = readCbIn;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = writeCbIn;
+	ioStreamIn->writeBytesVCb = NULL;
 	ioStreamIn->userVar = userVarIn;
 }
 
 
+void cxa_ioStream_bind_readBytes(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn)
+{
+	cxa_assert(ioStreamIn);
+
+	// must be called after cxa_ioStream_bind (which clears it)
+	ioStreamIn->readBytesCb = readBytesCbIn;
+}
+
+
+void cxa_ioStream_bind_writeBytesV(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_writeBytesV_t writeBytesVCbIn)
+{
+	cxa_assert(ioStreamIn);
+
+	// must be called after cxa_ioStream_bind (which clears it)
+	ioStreamIn->writeBytesVCb = writeBytesVCbIn;
+}
+
+
 void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn)
 {
 	cxa_assert(ioStreamIn);
 
 	ioStreamIn->readCb = NULL;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = NULL;
+	ioStreamIn->writeBytesVCb = NULL;
 	ioStreamIn->userVar = NULL;
 }
 
@@ -89,6 +111,35 @@ cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn
 }
 
 
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(buffOut);
+	cxa_assert(numBytesReadOut);
+
+	*numBytesReadOut = 0;
+
+	// make sure we're bound
+	if( !cxa_ioStream_isBound(ioStreamIn) ) return CXA_IOSTREAM_READSTAT_ERROR;
+	if( maxNumBytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	// preferably in one go
+	if( ioStreamIn->readBytesCb != NULL ) return ioStreamIn->readBytesCb((uint8_t*)buffOut, maxNumBytesIn, numBytesReadOut, ioStreamIn->userVar);
+
+	// otherwise, one byte at a time until the stream runs dry
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
+	while( *numBytesReadOut < maxNumBytesIn )
+	{
+		readStat = ioStreamIn->readCb(&((uint8_t*)buffOut)[*numBytesReadOut], ioStreamIn->userVar);
+		if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
+		(*numBytesReadOut)++;
+	}
+
+	// report what we got (any error will show up again on the next read)
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : readStat;
+}
+
+
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn)
 {
 	cxa_assert(ioStreamIn);
@@ -126,9 +177,13 @@ void cxa_ioStream_clearReadBuffer(cxa_ioStream_t *const ioStreamIn)
 {
 	cxa_assert(ioStreamIn);
 
-	for( int i = 0; i < CXA_IOSTREAM_MAXNUM_CLEARED_BYTES; i++ )
+	uint8_t discardBuffer[CXA_IOSTREAM_CLEAR_CHUNKSIZE_BYTES];
+	size_t numBytesCleared = 0;
+	while( numBytesCleared < CXA_IOSTREAM_MAXNUM_CLEARED_BYTES )
 	{
-		if( cxa_ioStream_readByte(ioStreamIn, NULL) != CXA_IOSTREAM_READSTAT_GOTDATA ) return;
+		size_t numBytesRead;
+		if( cxa_ioStream_readBytes(ioStreamIn, discardBuffer, CXA_MIN(sizeof(discardBuffer), (CXA_IOSTREAM_MAXNUM_CLEARED_BYTES - numBytesCleared)), &numBytesRead) != CXA_IOSTREAM_READSTAT_GOTDATA ) return;
+		numBytesCleared += numBytesRead;
 	}
 }
 
@@ -153,6 +208,29 @@ bool cxa_ioStream_writeBytes(cxa_ioStream_t *const ioStreamIn, void* buffIn, siz
 }
 
 
+bool cxa_ioStream_writeBytesV(cxa_ioStream_t *const ioStreamIn, cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn)
+{
+	cxa_assert(ioStreamIn);
+	if( numSegmentsIn > 0 ) cxa_assert(segmentsIn);
+
+	// make sure we're bound
+	if( !cxa_ioStream_isBound(ioStreamIn) ) return false;
+	if( numSegmentsIn == 0 ) return true;
+
+	// preferably all at once
+	if( ioStreamIn->writeBytesVCb != NULL ) return ioStreamIn->writeBytesVCb(segmentsIn, numSegmentsIn, ioStreamIn->userVar);
+
+	// otherwise, one segment at a time
+	for( size_t i = 0; i < numSegmentsIn; i++ )
+	{
+		if( segmentsIn[i].size_bytes == 0 ) continue;
+		if( !ioStreamIn->writeCb(segmentsIn[i].data, segmentsIn[i].size_bytes, ioStreamIn->userVar) ) return false;
+	}
+
+	return true;
+}
+
+
 bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const fbbIn)
 {
 	cxa_assert(ioStreamIn);
@@ -164,6 +242,44 @@ bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fix
 }
 
 
+bool cxa_ioStream_writeBufferChain(cxa_ioStream_t *const ioStreamIn, cxa_bufferChain_t *const chainIn)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(chainIn);
+
+	// each segment goes straight from where it lives (no intermediate copy)
+	size_t numSegments = cxa_bufferChain_getNumSegments(chainIn);
+	return (numSegments == 0) ? true : cxa_ioStream_writeBytesV(ioStreamIn, cxa_bufferChain_getSegment_atIndex(chainIn, 0), numSegments);
+}
+
+
+bool cxa_ioStream_writeBufferChain_framed(cxa_ioStream_t *const ioStreamIn,
+										  void *const headerIn, size_t headerSize_bytesIn,
+										  cxa_bufferChain_t *const chainIn,
+										  void *const footerIn, size_t footerSize_bytesIn)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(chainIn);
+
+	// header, body and footer in one vectored write (if they fit)
+	cxa_bufferChain_t framedChain;
+	cxa_bufferChain_segment_t framedChain_segments[CXA_IOSTREAM_MAXNUM_FRAMED_SEGMENTS];
+	cxa_bufferChain_initStd(&framedChain, framedChain_segments);
+
+	if( cxa_bufferChain_append(&framedChain, headerIn, headerSize_bytesIn) &&
+		cxa_bufferChain_append_chain(&framedChain, chainIn) &&
+		cxa_bufferChain_append(&framedChain, footerIn, footerSize_bytesIn) )
+	{
+		return cxa_ioStream_writeBufferChain(ioStreamIn, &framedChain);
+	}
+
+	// too many segments...write the pieces separately
+	if( (headerSize_bytesIn > 0) && !cxa_ioStream_writeBytes(ioStreamIn, headerIn, headerSize_bytesIn) ) return false;
+	if( !cxa_ioStream_writeBufferChain(ioStreamIn, chainIn) ) return false;
+	return (footerSize_bytesIn > 0) ? cxa_ioStream_writeBytes(ioStreamIn, footerIn, footerSize_bytesIn) : true;
+}
+
+
 bool cxa_ioStream_writeString(cxa_ioStream_t *const ioStreamIn, const char* stringIn)
 {
 	cxa_assert(ioStreamIn);
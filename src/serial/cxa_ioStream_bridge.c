@@ -13,12 +13,16 @@
 
 
 // ******** local macro definitions ********
+#ifndef CXA_IOSTREAM_BRIDGE_CHUNKSIZE_BYTES
+	#define CXA_IOSTREAM_BRIDGE_CHUNKSIZE_BYTES			32
+#endif
 
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
+static void forwardChunk(cxa_ioStream_t *const srcStreamIn, cxa_ioStream_t *const destStreamIn);
 static void cb_onRunLoopUpdate(void* userVarIn);
 
 
@@ -45,18 +49,22 @@ void cxa_ioStream_bridge_init(cxa_ioStream_bridge_t *const bridgeIn,
 
 
 // ******** local function implementations ********
-static void cb_onRunLoopUpdate(void* userVarIn)
+static void forwardChunk(cxa_ioStream_t *const srcStreamIn, cxa_ioStream_t *const destStreamIn)
 {
-	cxa_ioStream_bridge_t* bridgeIn = (cxa_ioStream_bridge_t*)userVarIn;
+	uint8_t buff[CXA_IOSTREAM_BRIDGE_CHUNKSIZE_BYTES];
+	size_t numBytesRead;
 
-	uint8_t rxByte;
-	if( cxa_ioStream_readByte(bridgeIn->stream1, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
+	if( cxa_ioStream_readBytes(srcStreamIn, buff, sizeof(buff), &numBytesRead) == CXA_IOSTREAM_READSTAT_GOTDATA )
 	{
-		cxa_ioStream_writeByte(bridgeIn->stream2, rxByte);
+		cxa_ioStream_writeBytes(destStreamIn, buff, numBytesRead);
 	}
+}
 
-	if( cxa_ioStream_readByte(bridgeIn->stream2, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
-	{
-		cxa_ioStream_writeByte(bridgeIn->stream1, rxByte);
-	}
+
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	cxa_ioStream_bridge_t* bridgeIn = (cxa_ioStream_bridge_t*)userVarIn;
+
+	forwardChunk(bridgeIn->stream1, bridgeIn->stream2);
+	forwardChunk(bridgeIn->stream2, bridgeIn->stream1);
 }
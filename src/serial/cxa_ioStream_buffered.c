@@ -0,0 +1,205 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_ioStream_buffered.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+#include <cxa_runLoop.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool bufferBytes(cxa_ioStream_buffered_t *const ioStreamIn, void *const buffIn, size_t bufferSize_bytesIn);
+static bool writeThrough(cxa_ioStream_buffered_t *const ioStreamIn, cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn);
+
+static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool writeBytesV_cb(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
+
+static void cb_onRunLoopIterationEnd(void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_ioStream_buffered_init(cxa_ioStream_buffered_t *const ioStreamIn,
+								cxa_ioStream_t *const underlyingStreamIn,
+								void *const bufferIn, const size_t bufferSize_bytesIn,
+								int threadIdIn)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(underlyingStreamIn);
+	cxa_assert(bufferIn);
+	cxa_assert(bufferSize_bytesIn > 0);
+
+	// save our references and set our initial state
+	ioStreamIn->underlyingStream = underlyingStreamIn;
+	ioStreamIn->buffer = (uint8_t*)bufferIn;
+	ioStreamIn->maxSize_bytes = bufferSize_bytesIn;
+	ioStreamIn->numBufferedBytes = 0;
+	ioStreamIn->flushThreshold_bytes = bufferSize_bytesIn;
+
+	// initialize our super class
+	cxa_ioStream_init(&ioStreamIn->super);
+	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
+	cxa_ioStream_bind_writeBytesV(&ioStreamIn->super, writeBytesV_cb);
+
+	// make sure nothing lingers past the end of an iteration
+	cxa_runLoop_addEndOfIterationCb(threadIdIn, cb_onRunLoopIterationEnd, (void*)ioStreamIn);
+}
+
+
+void cxa_ioStream_buffered_setFlushThreshold(cxa_ioStream_buffered_t *const ioStreamIn, const size_t flushThreshold_bytesIn)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert( (flushThreshold_bytesIn > 0) && (flushThreshold_bytesIn <= ioStreamIn->maxSize_bytes) );
+
+	ioStreamIn->flushThreshold_bytes = flushThreshold_bytesIn;
+	if( ioStreamIn->numBufferedBytes >= ioStreamIn->flushThreshold_bytes ) cxa_ioStream_buffered_flush(ioStreamIn);
+}
+
+
+bool cxa_ioStream_buffered_flush(cxa_ioStream_buffered_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	if( ioStreamIn->numBufferedBytes == 0 ) return true;
+
+	size_t numBytesToWrite = ioStreamIn->numBufferedBytes;
+	ioStreamIn->numBufferedBytes = 0;
+
+	return cxa_ioStream_writeBytes(ioStreamIn->underlyingStream, ioStreamIn->buffer, numBytesToWrite);
+}
+
+
+size_t cxa_ioStream_buffered_getNumBufferedBytes(cxa_ioStream_buffered_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	return ioStreamIn->numBufferedBytes;
+}
+
+
+// ******** local function implementations ********
+static bool bufferBytes(cxa_ioStream_buffered_t *const ioStreamIn, void *const buffIn, size_t bufferSize_bytesIn)
+{
+	// caller has made sure there is room
+	memcpy(&ioStreamIn->buffer[ioStreamIn->numBufferedBytes], buffIn, bufferSize_bytesIn);
+	ioStreamIn->numBufferedBytes += bufferSize_bytesIn;
+
+	return (ioStreamIn->numBufferedBytes >= ioStreamIn->flushThreshold_bytes) ? cxa_ioStream_buffered_flush(ioStreamIn) : true;
+}
+
+
+static bool writeThrough(cxa_ioStream_buffered_t *const ioStreamIn, cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn)
+{
+	// try to send our buffered bytes along with the new ones (one write)
+	if( (ioStreamIn->numBufferedBytes > 0) && (numSegmentsIn < CXA_IOSTREAM_MAXNUM_FRAMED_SEGMENTS) )
+	{
+		cxa_bufferChain_segment_t segments[CXA_IOSTREAM_MAXNUM_FRAMED_SEGMENTS];
+		segments[0].data = ioStreamIn->buffer;
+		segments[0].size_bytes = ioStreamIn->numBufferedBytes;
+		memcpy(&segments[1], segmentsIn, numSegmentsIn * sizeof(*segmentsIn));
+		ioStreamIn->numBufferedBytes = 0;
+
+		return cxa_ioStream_writeBytesV(ioStreamIn->underlyingStream, segments, numSegmentsIn+1);
+	}
+
+	// too many segments...do it in two steps
+	bool retVal = cxa_ioStream_buffered_flush(ioStreamIn);
+	return cxa_ioStream_writeBytesV(ioStreamIn->underlyingStream, segmentsIn, numSegmentsIn) && retVal;
+}
+
+
+static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_ioStream_buffered_t *const ioStreamIn = (cxa_ioStream_buffered_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	// reads are never buffered
+	return cxa_ioStream_readByte(ioStreamIn->underlyingStream, byteOut);
+}
+
+
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_ioStream_buffered_t *const ioStreamIn = (cxa_ioStream_buffered_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	// reads are never buffered
+	return cxa_ioStream_readBytes(ioStreamIn->underlyingStream, buffOut, maxNumBytesIn, numBytesReadOut);
+}
+
+
+static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_ioStream_buffered_t *const ioStreamIn = (cxa_ioStream_buffered_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	// simple case...it fits
+	if( bufferSize_bytesIn <= (ioStreamIn->maxSize_bytes - ioStreamIn->numBufferedBytes) )
+	{
+		return bufferBytes(ioStreamIn, buffIn, bufferSize_bytesIn);
+	}
+
+	// it will fit once we make some room
+	if( bufferSize_bytesIn < ioStreamIn->maxSize_bytes )
+	{
+		bool retVal = cxa_ioStream_buffered_flush(ioStreamIn);
+		return bufferBytes(ioStreamIn, buffIn, bufferSize_bytesIn) && retVal;
+	}
+
+	// too big to buffer at all
+	cxa_bufferChain_segment_t segment = {.data=buffIn, .size_bytes=bufferSize_bytesIn};
+	return writeThrough(ioStreamIn, &segment, 1);
+}
+
+
+static bool writeBytesV_cb(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn)
+{
+	cxa_ioStream_buffered_t *const ioStreamIn = (cxa_ioStream_buffered_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	size_t totalSize_bytes = 0;
+	for( size_t i = 0; i < numSegmentsIn; i++ )
+	{
+		totalSize_bytes += segmentsIn[i].size_bytes;
+	}
+
+	// doesn't fit...send it (and whatever we have) on its way
+	if( totalSize_bytes > (ioStreamIn->maxSize_bytes - ioStreamIn->numBufferedBytes) ) return writeThrough(ioStreamIn, segmentsIn, numSegmentsIn);
+
+	// gather everything into our buffer (only checking the threshold at the end)
+	for( size_t i = 0; i < numSegmentsIn; i++ )
+	{
+		if( segmentsIn[i].size_bytes == 0 ) continue;
+		memcpy(&ioStreamIn->buffer[ioStreamIn->numBufferedBytes], segmentsIn[i].data, segmentsIn[i].size_bytes);
+		ioStreamIn->numBufferedBytes += segmentsIn[i].size_bytes;
+	}
+
+	return (ioStreamIn->numBufferedBytes >= ioStreamIn->flushThreshold_bytes) ? cxa_ioStream_buffered_flush(ioStreamIn) : true;
+}
+
+
+static void cb_onRunLoopIterationEnd(void* userVarIn)
+{
+	cxa_ioStream_buffered_t *const ioStreamIn = (cxa_ioStream_buffered_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	cxa_ioStream_buffered_flush(ioStreamIn);
+}
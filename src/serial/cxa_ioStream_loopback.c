@@ -22,6 +22,7 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
@@ -39,6 +40,7 @@ void cxa_ioStream_loopback_init(cxa_ioStream_loopback_t *const ioStreamIn)
 	// initialize our super class
 	cxa_ioStream_init(&ioStreamIn->super);
 	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
 }
 
 
@@ -52,16 +54,21 @@ static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const use
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_loopback_t* ioStreamIn = (cxa_ioStream_loopback_t*)userVarIn;
+
+	*numBytesReadOut = cxa_fixedFifo_bulkDequeue_copy(&ioStreamIn->fifo, buffOut, maxNumBytesIn);
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_loopback_t* ioStreamIn = (cxa_ioStream_loopback_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
-
-	return true;
+	return cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo, buffIn, bufferSize_bytesIn);
 }
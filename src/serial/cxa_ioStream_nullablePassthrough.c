@@ -20,7 +20,9 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t cb_ioStream_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool cb_ioStream_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -36,6 +38,8 @@ void cxa_ioStream_nullablePassthrough_init(cxa_ioStream_nullablePassthrough_t *c
 	// setup our nonnull ioStream
 	cxa_ioStream_init(&npIn->nonnullStream);
 	cxa_ioStream_bind(&npIn->nonnullStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)npIn);
+	cxa_ioStream_bind_readBytes(&npIn->nonnullStream, cb_ioStream_readBytes);
+	cxa_ioStream_bind_writeBytesV(&npIn->nonnullStream, cb_ioStream_writeBytesV);
 
 	// and our nullable stream
 	npIn->nullableStream = NULL;
@@ -96,6 +100,17 @@ static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, vo
 }
 
 
+static cxa_ioStream_readStatus_t cb_ioStream_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_ioStream_nullablePassthrough_t *const npIn = (cxa_ioStream_nullablePassthrough_t*)userVarIn;
+	cxa_assert(npIn);
+
+	if( npIn->nullableStream == NULL ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	return cxa_ioStream_readBytes(npIn->nullableStream, buffOut, maxNumBytesIn, numBytesReadOut);
+}
+
+
 static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_ioStream_nullablePassthrough_t *const npIn = (cxa_ioStream_nullablePassthrough_t*)userVarIn;
@@ -107,3 +122,19 @@ static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 
 	return cxa_ioStream_writeBytes(npIn->nullableStream, buffIn, bufferSize_bytesIn);
 }
+
+
+static bool cb_ioStream_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn)
+{
+	cxa_ioStream_nullablePassthrough_t *const npIn = (cxa_ioStream_nullablePassthrough_t*)userVarIn;
+	cxa_assert(npIn);
+
+	for( size_t i = 0; i < numSegmentsIn; i++ )
+	{
+		npIn->numBytesWritten += segmentsIn[i].size_bytes;
+	}
+
+	if( npIn->nullableStream == NULL ) return true;
+
+	return cxa_ioStream_writeBytesV(npIn->nullableStream, segmentsIn, numSegmentsIn);
+}
@@ -22,7 +22,9 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool writeBytesV_cb(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -42,6 +44,8 @@ void cxa_ioStream_peekable_init(cxa_ioStream_peekable_t *const ioStreamIn,
 	// initialize our super class
 	cxa_ioStream_init(&ioStreamIn->super);
 	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
+	cxa_ioStream_bind_writeBytesV(&ioStreamIn->super, writeBytesV_cb);
 }
 
 
@@ -92,6 +96,33 @@ static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const use
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_ioStream_peekable_t *const ioStreamIn = (cxa_ioStream_peekable_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	// our buffered byte always comes first...
+	size_t numBufferedBytes = 0;
+	if( ioStreamIn->hasBufferedByte )
+	{
+		buffOut[0] = ioStreamIn->bufferedByte;
+		ioStreamIn->hasBufferedByte = false;
+		numBufferedBytes = 1;
+	}
+
+	// ...followed by whatever the underlying stream has
+	size_t numUnderlyingBytes = 0;
+	cxa_ioStream_readStatus_t retVal = CXA_IOSTREAM_READSTAT_NODATA;
+	if( numBufferedBytes < maxNumBytesIn )
+	{
+		retVal = cxa_ioStream_readBytes(ioStreamIn->underlyingStream, &buffOut[numBufferedBytes], (maxNumBytesIn - numBufferedBytes), &numUnderlyingBytes);
+	}
+
+	*numBytesReadOut = numBufferedBytes + numUnderlyingBytes;
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : retVal;
+}
+
+
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_ioStream_peekable_t *const ioStreamIn = (cxa_ioStream_peekable_t*)userVarIn;
@@ -100,3 +131,13 @@ static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVa
 	// call through to the underlying stream...
 	return cxa_ioStream_writeBytes(ioStreamIn->underlyingStream, buffIn, bufferSize_bytesIn);
 }
+
+
+static bool writeBytesV_cb(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn)
+{
+	cxa_ioStream_peekable_t *const ioStreamIn = (cxa_ioStream_peekable_t*)userVarIn;
+	cxa_assert(ioStreamIn);
+
+	// call through to the underlying stream...
+	return cxa_ioStream_writeBytesV(ioStreamIn->underlyingStream, segmentsIn, numSegmentsIn);
+}
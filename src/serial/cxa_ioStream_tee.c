@@ -22,10 +22,13 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t read_cb_ep1(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 static cxa_ioStream_readStatus_t read_cb_ep2(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 static cxa_ioStream_readStatus_t read_cb_ep3(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep3(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb_ep3(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
@@ -40,14 +43,17 @@ void cxa_ioStream_tee_init(cxa_ioStream_tee_t *const ioStreamIn)
 	// initialize our ioStreams
 	cxa_ioStream_init(&ioStreamIn->endPoint1);
 	cxa_ioStream_bind(&ioStreamIn->endPoint1, read_cb_ep1, write_cb_ep1, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->endPoint1, readBytes_cb_ep1);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep1Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep1Read_raw);
 
 	cxa_ioStream_init(&ioStreamIn->endPoint2);
 	cxa_ioStream_bind(&ioStreamIn->endPoint2, read_cb_ep2, write_cb_ep2, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->endPoint2, readBytes_cb_ep2);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep2Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep2Read_raw);
 
 	cxa_ioStream_init(&ioStreamIn->endPoint3);
 	cxa_ioStream_bind(&ioStreamIn->endPoint3, read_cb_ep3, write_cb_ep3, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->endPoint3, readBytes_cb_ep3);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep3Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep3Read_raw);
 }
 
@@ -82,19 +88,26 @@ static cxa_ioStream_readStatus_t read_cb_ep1(uint8_t *const byteOut, void *const
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
+
+	*numBytesReadOut = cxa_fixedFifo_bulkDequeue_copy(&ioStreamIn->fifo_ep1Read, buffOut, maxNumBytesIn);
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
 static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep2Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep3Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	bool retVal = cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep2Read, buffIn, bufferSize_bytesIn);
+	retVal &= cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep3Read, buffIn, bufferSize_bytesIn);
 
-	return true;
+	return retVal;
 }
 
 
@@ -107,19 +120,26 @@ static cxa_ioStream_readStatus_t read_cb_ep2(uint8_t *const byteOut, void *const
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
+
+	*numBytesReadOut = cxa_fixedFifo_bulkDequeue_copy(&ioStreamIn->fifo_ep2Read, buffOut, maxNumBytesIn);
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
 static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep1Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep3Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	bool retVal = cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep1Read, buffIn, bufferSize_bytesIn);
+	retVal &= cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep3Read, buffIn, bufferSize_bytesIn);
 
-	return true;
+	return retVal;
 }
 
 
@@ -132,17 +152,24 @@ static cxa_ioStream_readStatus_t read_cb_ep3(uint8_t *const byteOut, void *const
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb_ep3(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
+
+	*numBytesReadOut = cxa_fixedFifo_bulkDequeue_copy(&ioStreamIn->fifo_ep3Read, buffOut, maxNumBytesIn);
+	return (*numBytesReadOut > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
 static bool write_cb_ep3(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep1Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep2Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	bool retVal = cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep1Read, buffIn, bufferSize_bytesIn);
+	retVal &= cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep2Read, buffIn, bufferSize_bytesIn);
 
-	return true;
+	return retVal;
 }
@@ -9,7 +9,9 @@
 
 // ******** includes ********
 #include <stdio.h>
+#include <string.h>
 #include <cxa_assert.h>
+#include <cxa_numberUtils.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_DEBUG
 #include <cxa_logger_implementation.h>
@@ -22,6 +24,10 @@
 
 
 // ******** local function prototypes ********
+static cxa_ioStream_readStatus_t passthrough_cb_readByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t passthrough_cb_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+static bool passthrough_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool passthrough_cb_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -31,7 +37,7 @@
 void cxa_protocolParser_init(cxa_protocolParser_t *const ppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
 							 cxa_protocolParser_scm_isInErrorState_t scm_isInErrorIn, cxa_protocolParser_scm_canSetBuffer_t scm_canSetBufferIn,
 							 cxa_protocolParser_scm_gotoIdle_t scm_gotoIdleIn, cxa_protocolParser_scm_reset_t scm_resetIn,
-							 cxa_protocolParser_scm_writeBytes_t scm_writeBytesIn)
+							 cxa_protocolParser_scm_writeBytes_t scm_writeBytesIn, cxa_protocolParser_scm_writeChain_t scm_writeChainIn)
 {
 	cxa_assert(ppIn);
 	cxa_assert(ioStreamIn);
@@ -39,7 +45,7 @@ void cxa_protocolParser_init(cxa_protocolParser_t *const ppIn, cxa_ioStream_t *c
 	cxa_assert(scm_canSetBufferIn);
 	cxa_assert(scm_gotoIdleIn);
 	cxa_assert(scm_resetIn);
-	cxa_assert(scm_writeBytesIn);
+	cxa_assert( (scm_writeBytesIn != NULL) || (scm_writeChainIn != NULL) );
 
 	// save our references
 	ppIn->ioStream = ioStreamIn;
@@ -49,6 +55,10 @@ void cxa_protocolParser_init(cxa_protocolParser_t *const ppIn, cxa_ioStream_t *c
 	ppIn->scm_isInError = scm_isInErrorIn;
 	ppIn->scm_reset = scm_resetIn;
 	ppIn->scm_writeBytes = scm_writeBytesIn;
+	ppIn->scm_writeChain = scm_writeChainIn;
+
+	// our subclass will supply this if it reads ahead
+	ppIn->rxBlock = NULL;
 
 	// setup our timediff
 	cxa_timeDiff_init(&ppIn->td_timeout);
@@ -91,6 +101,7 @@ void cxa_protocolParser_reset(cxa_protocolParser_t *const ppIn)
 {
 	cxa_assert(ppIn);
 
+	cxa_protocolParser_rxBlock_discard(ppIn);
 	ppIn->scm_reset(ppIn);
 }
 
@@ -133,7 +144,16 @@ cxa_fixedByteBuffer_t* cxa_protocolParser_getBuffer(cxa_protocolParser_t *const
 bool cxa_protocolParser_writePacket(cxa_protocolParser_t *const ppIn, cxa_fixedByteBuffer_t *const dataIn)
 {
 	cxa_assert(ppIn);
-	return ppIn->scm_writeBytes(ppIn, dataIn);
+
+	if( ppIn->scm_writeBytes != NULL ) return ppIn->scm_writeBytes(ppIn, dataIn);
+
+	// our subclass only knows how to write chains
+	cxa_bufferChain_t chain;
+	cxa_bufferChain_segment_t chain_segments[1];
+	cxa_bufferChain_initStd(&chain, chain_segments);
+	if( dataIn != NULL ) cxa_bufferChain_append_fbb(&chain, dataIn);
+
+	return ppIn->scm_writeChain(ppIn, &chain);
 }
 
 
@@ -148,22 +168,120 @@ bool cxa_protocolParser_writePacket_bytes(cxa_protocolParser_t *const ppIn, void
 }
 
 
+bool cxa_protocolParser_writePacket_chain(cxa_protocolParser_t *const ppIn, cxa_bufferChain_t *const chainIn)
+{
+	cxa_assert(ppIn);
+	cxa_assert(chainIn);
+
+	if( ppIn->scm_writeChain != NULL ) return ppIn->scm_writeChain(ppIn, chainIn);
+
+	// our subclass only knows how to write buffers...we can handle simple chains without copying
+	size_t numSegments = cxa_bufferChain_getNumSegments(chainIn);
+	if( numSegments == 0 ) return ppIn->scm_writeBytes(ppIn, NULL);
+	if( numSegments > 1 )
+	{
+		cxa_logger_warn(&ppIn->logger, "multi-segment chains unsupported");
+		return false;
+	}
+
+	cxa_bufferChain_segment_t* segment = cxa_bufferChain_getSegment_atIndex(chainIn, 0);
+	return cxa_protocolParser_writePacket_bytes(ppIn, segment->data, segment->size_bytes);
+}
+
+
 void cxa_protocolParser_resetError(cxa_protocolParser_t *const ppIn)
 {
 	cxa_assert(ppIn);
 
 	// get to the idle state...the state machine
 	// should take care of the rest
+	cxa_protocolParser_rxBlock_discard(ppIn);
 	ppIn->scm_gotoIdle(ppIn);
 }
 
 
+cxa_ioStream_t* cxa_protocolParser_getPassthroughIoStream(cxa_protocolParser_t *const ppIn)
+{
+	cxa_assert(ppIn);
+
+	// nothing read ahead...nothing to pass through
+	return (ppIn->rxBlock != NULL) ? &ppIn->rxBlock->passthroughStream : ppIn->ioStream;
+}
+
+
+void cxa_protocolParser_rxBlock_discard(cxa_protocolParser_t *const ppIn)
+{
+	cxa_assert(ppIn);
+
+	if( ppIn->rxBlock == NULL ) return;
+
+	ppIn->rxBlock->readIndex = 0;
+	ppIn->rxBlock->numBytes = 0;
+}
+
+
+void cxa_protocolParser_setRxBlock(cxa_protocolParser_t *const ppIn, cxa_protocolParser_rxBlock_t *const rxBlockIn)
+{
+	cxa_assert(ppIn);
+	cxa_assert(rxBlockIn);
+
+	// nothing read ahead yet
+	rxBlockIn->readIndex = 0;
+	rxBlockIn->numBytes = 0;
+	cxa_ioStream_init(&rxBlockIn->passthroughStream);
+	cxa_ioStream_bind(&rxBlockIn->passthroughStream, passthrough_cb_readByte, passthrough_cb_writeBytes, (void*)ppIn);
+	cxa_ioStream_bind_readBytes(&rxBlockIn->passthroughStream, passthrough_cb_readBytes);
+	cxa_ioStream_bind_writeBytesV(&rxBlockIn->passthroughStream, passthrough_cb_writeBytesV);
+
+	ppIn->rxBlock = rxBlockIn;
+}
+
+
+cxa_ioStream_readStatus_t cxa_protocolParser_rxBlock_peek(cxa_protocolParser_t *const ppIn, uint8_t **const bytesOut, size_t *const numBytesOut)
+{
+	cxa_assert(ppIn);
+	cxa_assert(ppIn->rxBlock);
+	cxa_assert(bytesOut);
+	cxa_assert(numBytesOut);
+
+	cxa_protocolParser_rxBlock_t* rxBlock = ppIn->rxBlock;
+	if( rxBlock->readIndex == rxBlock->numBytes )
+	{
+		// we've consumed everything...get the next block
+		rxBlock->readIndex = 0;
+		rxBlock->numBytes = 0;
+
+		size_t numBytesRead = 0;
+		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readBytes(ppIn->ioStream, rxBlock->buffer, sizeof(rxBlock->buffer), &numBytesRead);
+		if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) return readStat;
+		rxBlock->numBytes = numBytesRead;
+	}
+
+	*bytesOut = &rxBlock->buffer[rxBlock->readIndex];
+	*numBytesOut = rxBlock->numBytes - rxBlock->readIndex;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+void cxa_protocolParser_rxBlock_consume(cxa_protocolParser_t *const ppIn, size_t numBytesIn)
+{
+	cxa_assert(ppIn);
+	cxa_assert(ppIn->rxBlock);
+	cxa_assert(numBytesIn <= (ppIn->rxBlock->numBytes - ppIn->rxBlock->readIndex));
+
+	ppIn->rxBlock->readIndex += numBytesIn;
+}
+
+
 void cxa_protocolParser_notify_ioException(cxa_protocolParser_t *const ppIn)
 {
 	cxa_assert(ppIn);
 
 	cxa_logger_error(&ppIn->logger, "underlying serial device is broken, protocol parser is inoperable");
 
+	// whatever we read ahead can't be trusted anymore
+	cxa_protocolParser_rxBlock_discard(ppIn);
+
 	// notify our protocol listeners
 	cxa_array_iterate(&ppIn->protocolListeners, currEntry, cxa_protocolParser_protocolListener_entry_t)
 	{
@@ -207,3 +325,51 @@ void cxa_protocolParser_notify_packetReceived(cxa_protocolParser_t *const ppIn,
 
 
 // ******** local function implementations ********
+static cxa_ioStream_readStatus_t passthrough_cb_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	uint8_t rxByte;
+	size_t numBytesRead;
+	cxa_ioStream_readStatus_t retVal = passthrough_cb_readBytes(&rxByte, 1, &numBytesRead, userVarIn);
+	if( (retVal == CXA_IOSTREAM_READSTAT_GOTDATA) && (byteOut != NULL) ) *byteOut = rxByte;
+
+	return retVal;
+}
+
+
+static cxa_ioStream_readStatus_t passthrough_cb_readBytes(uint8_t *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_protocolParser_t* ppIn = (cxa_protocolParser_t*)userVarIn;
+	cxa_assert(ppIn);
+
+	// anything we've read ahead comes first...
+	cxa_protocolParser_rxBlock_t* rxBlock = ppIn->rxBlock;
+	size_t numBlockBytes = CXA_MIN((rxBlock->numBytes - rxBlock->readIndex), maxNumBytesIn);
+	if( numBlockBytes > 0 )
+	{
+		memcpy(buffOut, &rxBlock->buffer[rxBlock->readIndex], numBlockBytes);
+		rxBlock->readIndex += numBlockBytes;
+		*numBytesReadOut = numBlockBytes;
+		return CXA_IOSTREAM_READSTAT_GOTDATA;
+	}
+
+	// ...followed by the underlying stream
+	return cxa_ioStream_readBytes(ppIn->ioStream, buffOut, maxNumBytesIn, numBytesReadOut);
+}
+
+
+static bool passthrough_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_protocolParser_t* ppIn = (cxa_protocolParser_t*)userVarIn;
+	cxa_assert(ppIn);
+
+	return cxa_ioStream_writeBytes(ppIn->ioStream, buffIn, bufferSize_bytesIn);
+}
+
+
+static bool passthrough_cb_writeBytesV(cxa_bufferChain_segment_t *const segmentsIn, size_t numSegmentsIn, void *const userVarIn)
+{
+	cxa_protocolParser_t* ppIn = (cxa_protocolParser_t*)userVarIn;
+	cxa_assert(ppIn);
+
+	return cxa_ioStream_writeBytesV(ppIn->ioStream, segmentsIn, numSegmentsIn);
+}
@@ -8,14 +8,17 @@
 
 
 // ******** includes ********
+#include <string.h>
 #include <cxa_assert.h>
+#include <cxa_numberUtils.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_INFO
 #include <cxa_logger_implementation.h>
 
 
 // ******** local macro definitions ********
-#define MAX_NUM_RX_BYTES_PER_UPDATE		16
+#define MAX_NUM_RX_BLOCKS_PER_UPDATE	4
+#define HEADER_SIZE_BYTES				4
 #define RECEPTION_TIMEOUT_MS			5000
 
 
@@ -37,7 +40,7 @@ static bool scm_isInErrorState(cxa_protocolParser_t *const superIn);
 static bool scm_canSetBuffer(cxa_protocolParser_t *const superIn);
 static void scm_gotoIdle(cxa_protocolParser_t *const superIn);
 static void scm_reset(cxa_protocolParser_t *const superIn);
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn);
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn);
 
 
 static void rxState_cb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -61,7 +64,8 @@ void cxa_protocolParser_cleProto_init(cxa_protocolParser_cleProto_t *const clePp
 	cxa_assert(ioStreamIn);
 
 	// initialize our super class
-	cxa_protocolParser_init(&clePpIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, scm_writeBytes);
+	cxa_protocolParser_init(&clePpIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, NULL, scm_writeChain);
+	cxa_protocolParser_setRxBlock(&clePpIn->super, &clePpIn->rxBlock);
 
 	// setup our state machine
 	cxa_stateMachine_init(&clePpIn->stateMachine, "protocolParser", threadIdIn);
@@ -119,33 +123,24 @@ static void scm_reset(cxa_protocolParser_t *const superIn)
 }
 
 
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn)
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn)
 {
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)superIn;
 	cxa_assert(clePpIn);
 
 	// message _should_ be configured properly...get our size
-	size_t msgSize_bytes = (fbbIn != NULL) ? cxa_fixedByteBuffer_getSize_bytes(fbbIn) : 0;
+	size_t msgSize_bytes = cxa_bufferChain_getSize_bytes(chainIn);
 	cxa_assert(msgSize_bytes <= (65535-3));
 
 	// make sure we're in a good state
 	if( clePpIn->super.scm_isInError(&clePpIn->super) || !cxa_ioStream_isBound(clePpIn->super.ioStream) ) return false;
 
-	// write our header
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x80) ) return false;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x81) ) return false;
-
+	// header, data and footer in one write
 	size_t len = msgSize_bytes + 1;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, ((len & 0x00FF) >> 0)) ) return false;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, ((len & 0xFF00) >> 8)) ) return false;
-
-	// write our data
-	if( (fbbIn != NULL) && !cxa_ioStream_writeFixedByteBuffer(clePpIn->super.ioStream, fbbIn) ) return false;
-
-	// write our footer
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x82) ) return false;
+	uint8_t header[] = {0x80, 0x81, ((len & 0x00FF) >> 0), ((len & 0xFF00) >> 8)};
+	uint8_t footer[] = {0x82};
 
-	return true;
+	return cxa_ioStream_writeBufferChain_framed(clePpIn->super.ioStream, header, sizeof(header), chainIn, footer, sizeof(footer));
 }
 
 
@@ -186,26 +181,32 @@ static void rxState_cb_wait0x80_state(cxa_stateMachine_t *const smIn, void *user
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
 	cxa_assert(clePpIn);
 
-	uint8_t rxByte;
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
+	for( uint8_t i = 0; i < MAX_NUM_RX_BLOCKS_PER_UPDATE; i++ )
 	{
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
+		uint8_t* rxBytes;
+		size_t numRxBytes;
+		cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&clePpIn->super, &rxBytes, &numRxBytes);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+		else if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) return;
+
+		// skip everything up to our first header byte
+		uint8_t* headerStart = memchr(rxBytes, 0x80, numRxBytes);
+		if( headerStart == NULL )
 		{
-			if( rxByte == 0x80 )
-			{
-				// we've gotten our first header byte
-				cxa_fixedByteBuffer_clear(clePpIn->super.currBuffer);
-				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
+			cxa_protocolParser_rxBlock_consume(&clePpIn->super, numRxBytes);
+			continue;
+		}
+		cxa_protocolParser_rxBlock_consume(&clePpIn->super, (size_t)(headerStart-rxBytes)+1);
 
-				// start our reception timeout timeDiff
-				cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+		// we've gotten our first header byte
+		cxa_fixedByteBuffer_clear(clePpIn->super.currBuffer);
+		cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, 0x80);
 
-				cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x81);
-				return;
-			}
-		}
+		// start our reception timeout timeDiff
+		cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+
+		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x81);
+		return;
 	}
 }
 
@@ -215,11 +216,15 @@ static void rxState_cb_wait0x81_state(cxa_stateMachine_t *const smIn, void *user
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
 	cxa_assert(clePpIn);
 
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
+	uint8_t* rxBytes;
+	size_t numRxBytes;
+	cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&clePpIn->super, &rxBytes, &numRxBytes);
 	if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
 	else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 	{
+		uint8_t rxByte = rxBytes[0];
+		cxa_protocolParser_rxBlock_consume(&clePpIn->super, 1);
+
 		// reset our reception timeout timeDiff
 		cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
 
@@ -253,21 +258,40 @@ static void rxState_cb_waitLen_state(cxa_stateMachine_t *const smIn, void *userV
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
 	cxa_assert(clePpIn);
 
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
+	uint8_t* rxBytes;
+	size_t numRxBytes;
+	cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&clePpIn->super, &rxBytes, &numRxBytes);
 	if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
 	else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 	{
-		// reset our reception timeout timeDiff
-		cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+		// take as many length bytes as we have
+		size_t numBytesToAppend = CXA_MIN(numRxBytes, HEADER_SIZE_BYTES - cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer));
+		cxa_fixedByteBuffer_append(clePpIn->super.currBuffer, rxBytes, numBytesToAppend);
+		cxa_protocolParser_rxBlock_consume(&clePpIn->super, numBytesToAppend);
+
+		// reset our reception timeout timeDiff (only if we actually made progress)
+		if( numBytesToAppend > 0 ) cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
 
-		// just append the byte
-		cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-		if( cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) == 4 )
+		if( cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) == HEADER_SIZE_BYTES )
 		{
 			// we have all of our length bytes...make sure it's valid
 			uint16_t len_bytes;
-			if( cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, len_bytes) && (len_bytes >= 1) ) cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES);
+			if( !cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, len_bytes) || (len_bytes < 1) )
+			{
+				cxa_logger_debug(&clePpIn->super.logger, "invalid message length: %d", len_bytes);
+				cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+				return;
+			}
+
+			// and that it will fit
+			if( (HEADER_SIZE_BYTES + (size_t)len_bytes) > cxa_fixedByteBuffer_getMaxSize_bytes(clePpIn->super.currBuffer) )
+			{
+				cxa_logger_debug(&clePpIn->super.logger, "message too large for buffer: %d", len_bytes);
+				cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+				return;
+			}
+
+			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES);
 			return;
 		}
 	}
@@ -295,31 +319,35 @@ static void rxState_cb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void
 		return;
 	}
 
-	// do a limited number of iterations
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
+	// do a limited number of iterations (each copies as much of a block as we need)
+	for( uint8_t i = 0; i < MAX_NUM_RX_BLOCKS_PER_UPDATE; i++ )
 	{
-		size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) - 4;
+		size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) - HEADER_SIZE_BYTES;
 
 		if( currSize_bytes < expectedSize_bytes )
 		{
 			// we have more bytes to receive
-			uint8_t rxByte;
-			cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
+			uint8_t* rxBytes;
+			size_t numRxBytes;
+			cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&clePpIn->super, &rxBytes, &numRxBytes);
 			if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-			else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
-			{
-				// reset our reception timeout timeDiff
-				cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+			else if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
 
-				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-			}
-		}
-		else
-		{
-			// we're done receiving our data bytes
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET);
-			return;
+			// reset our reception timeout timeDiff
+			cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+
+			size_t numBytesToAppend = CXA_MIN(numRxBytes, (expectedSize_bytes - currSize_bytes));
+			cxa_fixedByteBuffer_append(clePpIn->super.currBuffer, rxBytes, numBytesToAppend);
+			cxa_protocolParser_rxBlock_consume(&clePpIn->super, numBytesToAppend);
 		}
+		else break;
+	}
+
+	if( (cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) - HEADER_SIZE_BYTES) >= expectedSize_bytes )
+	{
+		// we're done receiving our data bytes
+		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET);
+		return;
 	}
 
 	// check to see if we've had a reception timeout
@@ -346,14 +374,14 @@ static void rxState_cb_processPacket_state(cxa_stateMachine_t *const smIn, void
 	if( (currSize_bytes >= 5) &&
 		(cxa_fixedByteBuffer_get_uint8(clePpIn->super.currBuffer, 0, tmpVal8) && (tmpVal8 == 0x80)) &&
 		(cxa_fixedByteBuffer_get_uint8(clePpIn->super.currBuffer, 1, tmpVal8) && (tmpVal8 == 0x81)) &&
-		(cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, tmpVal16) && (tmpVal16 == (currSize_bytes-4))) &&
+		(cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, tmpVal16) && (tmpVal16 == (currSize_bytes-HEADER_SIZE_BYTES))) &&
 		(cxa_fixedByteBuffer_get_uint8(clePpIn->super.currBuffer, currSize_bytes-1, tmpVal8) && (tmpVal8 == 0x82)) )
 	{
 		// we received a message
 		cxa_logger_trace(&clePpIn->super.logger, "message received...calling listeners");
 
 		// ...but first, strip the header and footer
-		cxa_fixedByteBuffer_remove(clePpIn->super.currBuffer, 0, 4);
+		cxa_fixedByteBuffer_remove(clePpIn->super.currBuffer, 0, HEADER_SIZE_BYTES);
 		cxa_fixedByteBuffer_remove(clePpIn->super.currBuffer, cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer)-1, 1);
 
 		cxa_protocolParser_notify_packetReceived(&clePpIn->super, clePpIn->super.currBuffer);
@@ -8,14 +8,16 @@
 
 
 // ******** includes ********
+#include <string.h>
 #include <cxa_assert.h>
+#include <cxa_numberUtils.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_DEBUG
 #include <cxa_logger_implementation.h>
 
 
 // ******** local macro definitions ********
-#define MAX_NUM_RX_BYTES_PER_UPDATE		16
+#define MAX_NUM_RX_BLOCKS_PER_UPDATE	4
 #define RECEPTION_TIMEOUT_MS			5000
 
 
@@ -36,9 +38,11 @@ static bool scm_isInErrorState(cxa_protocolParser_t *const superIn);
 static bool scm_canSetBuffer(cxa_protocolParser_t *const superIn);
 static void scm_gotoIdle(cxa_protocolParser_t *const superIn);
 static void scm_reset(cxa_protocolParser_t *const superIn);
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn);
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn);
 
 
+static bool scanForCrLf(cxa_protocolParser_crlf_t *const crlfPpIn, bool isLastByteCrIn);
+
 static void rxState_cb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void *userVarIn);
@@ -61,7 +65,8 @@ void cxa_protocolParser_crlf_init(cxa_protocolParser_crlf_t *const crlfPpIn, cxa
 	crlfPpIn->isPaused = true;
 
 	// initialize our super class
-	cxa_protocolParser_init(&crlfPpIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, scm_writeBytes);
+	cxa_protocolParser_init(&crlfPpIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_reset, NULL, scm_writeChain);
+	cxa_protocolParser_setRxBlock(&crlfPpIn->super, &crlfPpIn->rxBlock);
 
 	// setup our state machine
 	cxa_stateMachine_init(&crlfPpIn->stateMachine, "crlfParser", threadIdIn);
@@ -137,18 +142,13 @@ static void scm_reset(cxa_protocolParser_t *const superIn)
 }
 
 
-static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuffer_t *const fbbIn)
+static bool scm_writeChain(cxa_protocolParser_t *const superIn, cxa_bufferChain_t *const chainIn)
 {
 	cxa_protocolParser_crlf_t* crlfPpIn = (cxa_protocolParser_crlf_t*)superIn;
 	cxa_assert(crlfPpIn);
 
-	// write our data
-	if( (fbbIn != NULL) && !cxa_ioStream_writeFixedByteBuffer(crlfPpIn->super.ioStream, fbbIn) ) return false;
-
-	// write our CRLF
-	if( !cxa_ioStream_writeString(crlfPpIn->super.ioStream, "\r\n") ) return false;
-
-	return true;
+	// write our data followed by our CRLF
+	return cxa_ioStream_writeBufferChain_framed(crlfPpIn->super.ioStream, NULL, 0, chainIn, (void*)"\r\n", 2);
 }
 
 
@@ -184,101 +184,93 @@ static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateI
 }
 
 
-static void rxState_cb_waitFirstByte_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static bool scanForCrLf(cxa_protocolParser_crlf_t *const crlfPpIn, bool isLastByteCrIn)
 {
-	cxa_protocolParser_crlf_t* crlfPpIn = (cxa_protocolParser_crlf_t*)userVarIn;
-	cxa_assert(crlfPpIn);
-
-	uint8_t rxByte;
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
+	bool isLastByteCr = isLastByteCrIn;
+	for( uint8_t i = 0; i < MAX_NUM_RX_BLOCKS_PER_UPDATE; i++ )
 	{
 		// make sure we haven't been paused
-		if( crlfPpIn->isPaused ) return;
+		if( crlfPpIn->isPaused ) break;
+
+		uint8_t* rxBytes;
+		size_t numRxBytes;
+		cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&crlfPpIn->super, &rxBytes, &numRxBytes);
+		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return true; }
+		else if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
+
+		// reset our reception timeout timeDiff
+		cxa_timeDiff_setStartTime_now(&crlfPpIn->super.td_timeout);
 
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
-		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return; }
-		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+		// find the first LF which follows a CR (which may have been at the end of the previous block)
+		uint8_t* lf = memchr(rxBytes, '\n', numRxBytes);
+		while( (lf != NULL) && !((lf == rxBytes) ? isLastByteCr : (lf[-1] == '\r')) )
 		{
-			// we've gotten our first byte
-			cxa_fixedByteBuffer_clear(crlfPpIn->super.currBuffer);
-			cxa_fixedByteBuffer_append_uint8(crlfPpIn->super.currBuffer, rxByte);
-
-			// reset our reception timeout timeDiff
-			cxa_timeDiff_setStartTime_now(&crlfPpIn->super.td_timeout);
-
-			// next state depends on the byte
-			if( rxByte == '\r' )
-			{
-				cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_LF);
-			}
-			else
-			{
-				cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_CR);
-			}
-			return;
+			lf = memchr(lf+1, '\n', numRxBytes - (size_t)(lf+1-rxBytes));
 		}
+
+		// save everything up to (and including) the LF in one go (dropping whatever doesn't fit)
+		size_t numBytesToConsume = (lf != NULL) ? (size_t)(lf-rxBytes)+1 : numRxBytes;
+		size_t numBytesToSave = CXA_MIN(numBytesToConsume, cxa_fixedByteBuffer_getFreeSize_bytes(crlfPpIn->super.currBuffer));
+		if( numBytesToSave > 0 ) cxa_fixedByteBuffer_append(crlfPpIn->super.currBuffer, rxBytes, numBytesToSave);
+		cxa_protocolParser_rxBlock_consume(&crlfPpIn->super, numBytesToConsume);
+
+		if( lf != NULL )
+		{
+			cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_PROCESS_PACKET);
+			return true;
+		}
+		isLastByteCr = (rxBytes[numRxBytes-1] == '\r');
 	}
+
+	// remember whether we're part way through a CRLF
+	rxState_t nextState = isLastByteCr ? RX_STATE_WAIT_LF : RX_STATE_WAIT_CR;
+	if( cxa_stateMachine_getCurrentState(&crlfPpIn->stateMachine) != (int)nextState ) cxa_stateMachine_transition(&crlfPpIn->stateMachine, nextState);
+
+	return false;
 }
 
 
-static void rxState_cb_waitCrLf_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxState_cb_waitFirstByte_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 {
 	cxa_protocolParser_crlf_t* crlfPpIn = (cxa_protocolParser_crlf_t*)userVarIn;
 	cxa_assert(crlfPpIn);
 
-	uint8_t rxByte;
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
+	// make sure we haven't been paused
+	if( crlfPpIn->isPaused ) return;
+
+	uint8_t* rxBytes;
+	size_t numRxBytes;
+	cxa_ioStream_readStatus_t readStat = cxa_protocolParser_rxBlock_peek(&crlfPpIn->super, &rxBytes, &numRxBytes);
+	if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return; }
+	else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 	{
-		// make sure we haven't been paused
-		if( crlfPpIn->isPaused ) return;
+		// we've gotten the start of a packet
+		cxa_fixedByteBuffer_clear(crlfPpIn->super.currBuffer);
 
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
-		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return; }
-		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
-		{
-			// reset our reception timeout timeDiff
-			cxa_timeDiff_setStartTime_now(&crlfPpIn->super.td_timeout);
-
-			// save the byte
-			cxa_fixedByteBuffer_append_uint8(crlfPpIn->super.currBuffer, rxByte);
-
-			// see if we got the next byte we're looking for
-			rxState_t currState = cxa_stateMachine_getCurrentState(&crlfPpIn->stateMachine);
-			uint8_t targetByte = (currState == RX_STATE_WAIT_LF) ? '\n' : '\r';
-
-			if( rxByte == targetByte )
-			{
-				// this is the byte we're looking for
-				if( currState == RX_STATE_WAIT_CR )
-				{
-					cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_LF);
-					return;
-				}
-				else if( currState == RX_STATE_WAIT_LF )
-				{
-					cxa_stateMachine_transition(smIn, RX_STATE_PROCESS_PACKET);
-					return;
-				}
-			}
-			else
-			{
-				// if we already moved on in the state machine, reset ourselves
-				if( currState == RX_STATE_WAIT_LF )
-				{
-					cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_CR);
-					return;
-				}
-			}
-		}
+		// reset our reception timeout timeDiff
+		cxa_timeDiff_setStartTime_now(&crlfPpIn->super.td_timeout);
 
-		// check to see if we've had a reception timeout
-		if( cxa_timeDiff_isElapsed_ms(&crlfPpIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
-		{
-			cxa_logger_debug_memDump_fbb(&crlfPpIn->super.logger, "buff: ", crlfPpIn->super.currBuffer, NULL);
-			cxa_protocolParser_notify_receptionTimeout(&crlfPpIn->super);
-			cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_FIRSTBYTE);
-			return;
-		}
+		// no need to wait for the next update to start looking for the end
+		scanForCrLf(crlfPpIn, false);
+	}
+}
+
+
+static void rxState_cb_waitCrLf_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_protocolParser_crlf_t* crlfPpIn = (cxa_protocolParser_crlf_t*)userVarIn;
+	cxa_assert(crlfPpIn);
+
+	rxState_t currState = cxa_stateMachine_getCurrentState(&crlfPpIn->stateMachine);
+	if( scanForCrLf(crlfPpIn, (currState == RX_STATE_WAIT_LF)) ) return;
+
+	// check to see if we've had a reception timeout
+	if( cxa_timeDiff_isElapsed_ms(&crlfPpIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
+	{
+		cxa_logger_debug_memDump_fbb(&crlfPpIn->super.logger, "buff: ", crlfPpIn->super.currBuffer, NULL);
+		cxa_protocolParser_notify_receptionTimeout(&crlfPpIn->super);
+		cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_FIRSTBYTE);
+		return;
 	}
 }
 
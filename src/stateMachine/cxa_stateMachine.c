@@ -26,6 +26,7 @@
 static void cb_onRunLoopUpdate(void* userVarIn);
 
 static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn);
+static bool appendState(cxa_stateMachine_t *const smIn, cxa_stateMachine_state_t *const stateIn);
 
 
 // ********  local variable declarations *********
@@ -44,6 +45,9 @@ void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn, i
 
 	// setup our internal state
 	cxa_array_init(&smIn->states, sizeof(*smIn->states_raw), (void*)smIn->states_raw, sizeof(smIn->states_raw));
+	#ifdef CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP
+	cxa_hashMap_initStd(&smIn->statesById, CXA_HASHMAP_KEYTYPE_INT, smIn->statesById_entries);
+	#endif
 
 	// setup our logger if it's enabled
 	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
@@ -53,8 +57,9 @@ void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn, i
 	// a timediff was _not_ supplied so we cannot do timed states
 	// even if they are enabled
 	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-	cxa_timeDiff_init(&smIn->td_timedTransition);
+	cxa_timeDiff64_init(&smIn->td_timedTransition);
 	smIn->timedStatesEnabled = true;
+	smIn->threadId = threadIdIn;
 	#endif
 
 	// register for run loop execution
@@ -79,7 +84,7 @@ void cxa_stateMachine_addState(cxa_stateMachine_t *const smIn, int idIn, const c
 		.cb_enter=cb_enterIn, .cb_state=cb_stateIn, .cb_leave=cb_leaveIn, .userVar=userVarIn};
 
 	// add the new state to our array of states
-	cxa_assert_msg(cxa_array_append(&smIn->states, &newState), "increase 'CXA_STATE_MACHINE_MAXNUM_STATES'");
+	cxa_assert_msg(appendState(smIn, &newState), "increase 'CXA_STATE_MACHINE_MAXNUM_STATES'");
 }
 
 
@@ -102,7 +107,7 @@ void cxa_stateMachine_addState_timed(cxa_stateMachine_t *const smIn, int idIn, c
 		.cb_enter=cb_enterIn, .cb_state=cb_stateIn, .cb_leave=cb_leaveIn, .userVar=userVarIn};
 
 	// add the new state to our array of states
-	cxa_assert(cxa_array_append(&smIn->states, &newState));
+	cxa_assert(appendState(smIn, &newState));
 }
 #endif
 
@@ -193,7 +198,7 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		if( smIn->currState->cb_enter != NULL ) smIn->currState->cb_enter(smIn, prevStateId, smIn->currState->userVar);
 
 		#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-			if( smIn->timedStatesEnabled && (smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) ) cxa_timeDiff_setStartTime_now(&smIn->td_timedTransition);
+			if( smIn->timedStatesEnabled && (smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) ) cxa_timeDiff64_setStartTime_ns(&smIn->td_timedTransition, cxa_runLoop_getIterationTime_ns(smIn->threadId));
 		#endif
 	}
 	else
@@ -202,7 +207,7 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 			// see if our state's time has expired...if so, transition into our next state
 			if(  smIn->timedStatesEnabled &&
 				(smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) &&
-				 cxa_timeDiff_isElapsed_ms(&smIn->td_timedTransition, smIn->currState->stateTime_ms) )
+				(cxa_timeDiff64_getElapsedTime_ns(&smIn->td_timedTransition, cxa_runLoop_getIterationTime_ns(smIn->threadId)) >= ((uint64_t)smIn->currState->stateTime_ms * 1000000)) )
 			{
 				cxa_stateMachine_transition(smIn, smIn->currState->nextStateId);
 				return;
@@ -219,6 +224,10 @@ static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, i
 {
 	cxa_assert(smIn);
 
+	#ifdef CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP
+	void* retVal;
+	return cxa_hashMap_get_int(&smIn->statesById, (uint32_t)idIn, &retVal) ? (cxa_stateMachine_state_t*)retVal : NULL;
+	#else
 	for( size_t i = 0; i < cxa_array_getSize_elems(&smIn->states); i++ )
 	{
 		cxa_stateMachine_state_t* currState = (cxa_stateMachine_state_t*)cxa_array_get(&smIn->states, i);
@@ -228,4 +237,18 @@ static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, i
 	}
 
 	return NULL;
+	#endif
+}
+
+
+static bool appendState(cxa_stateMachine_t *const smIn, cxa_stateMachine_state_t *const stateIn)
+{
+	if( !cxa_array_append(&smIn->states, stateIn) ) return false;
+
+	#ifdef CXA_STATE_MACHINE_ENABLE_HASHED_LOOKUP
+	cxa_stateMachine_state_t* storedState = (cxa_stateMachine_state_t*)cxa_array_get(&smIn->states, cxa_array_getSize_elems(&smIn->states)-1);
+	if( !cxa_hashMap_put_int(&smIn->statesById, (uint32_t)stateIn->stateId, storedState) ) return false;
+	#endif
+
+	return true;
 }
@@ -71,4 +71,69 @@ bool cxa_timeDiff_isElapsed_recurring_ms(cxa_timeDiff_t *const tdIn, uint32_t ms
 }
 
 
+void cxa_timeDiff64_init(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	cxa_timeDiff64_setStartTime_now(tdIn);
+}
+
+
+void cxa_timeDiff64_setStartTime_now(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	tdIn->startTime_ns = cxa_timeBase_getCount_ns();
+}
+
+
+void cxa_timeDiff64_setStartTime_ns(cxa_timeDiff64_t *const tdIn, uint64_t startTime_nsIn)
+{
+	cxa_assert(tdIn);
+
+	tdIn->startTime_ns = startTime_nsIn;
+}
+
+
+uint64_t cxa_timeDiff64_getElapsedTime_ns(cxa_timeDiff64_t *const tdIn, uint64_t now_nsIn)
+{
+	cxa_assert(tdIn);
+
+	// a cached 'now' may be slightly older than our start time
+	return (now_nsIn > tdIn->startTime_ns) ? (now_nsIn - tdIn->startTime_ns) : 0;
+}
+
+
+uint64_t cxa_timeDiff64_getElapsedTime_ms(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	return cxa_timeDiff64_getElapsedTime_ns(tdIn, cxa_timeBase_getCount_ns()) / 1000000;
+}
+
+
+bool cxa_timeDiff64_isElapsed_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn)
+{
+	cxa_assert(tdIn);
+
+	return (cxa_timeDiff64_getElapsedTime_ms(tdIn) >= msIn);
+}
+
+
+bool cxa_timeDiff64_isElapsed_recurring_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn)
+{
+	cxa_assert(tdIn);
+
+	uint64_t now_ns = cxa_timeBase_getCount_ns();
+	uint64_t period_ns = (uint64_t)msIn * 1000000;
+	if( cxa_timeDiff64_getElapsedTime_ns(tdIn, now_ns) < period_ns ) return false;
+
+	// if we've fallen more than a period behind, don't try to catch up
+	tdIn->startTime_ns += period_ns;
+	if( (now_ns - tdIn->startTime_ns) >= period_ns ) tdIn->startTime_ns = now_ns;
+
+	return true;
+}
+
+
 // ******** local function implementations ********